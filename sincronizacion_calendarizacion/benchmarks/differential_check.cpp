@@ -0,0 +1,526 @@
+// Verificación diferencial de los motores optimizados contra el código de la versión base.
+//
+// Uso: differential_check [--cases N] [--seed N] [--max-processes N] [--max-actions N] [--verbose]
+//
+// Genera cargas al azar y las corre en los dos lados:
+//  - CPU: FIFO, SJF, SRT, Round Robin y Priority Aging de schedulercore.h contra los
+//    ejecutar* de la ventana base (reference_engines.h). Se comparan los tramos exactos
+//    (PID, inicio, duración) después de unir los consecutivos del mismo proceso. Si las
+//    corridas se separan donde los dos procesos elegidos empatan en la clave de la
+//    política, es un empate documentado: se cuenta aparte y no se sigue comparando.
+//  - Sincronización: SyncEngine contra runSimulationStep de la ventana base, avanzando un
+//    ciclo a la vez, con una carga dentro de lo que la base sabe hacer (mutex o semáforo,
+//    retención de un ciclo, un despertar por ciclo). En cada ciclo se comparan los eventos
+//    y la cola de espera de cada recurso; al final, los tiempos de cada acción.
+//  - Con otra carga que usa todos los modos, runShardedSimulation contra SyncEngine.
+// Las excepciones están en reference_engines.h. El caso i usa la semilla --seed + i, así
+// que "--seed S --cases 1" repite solo el caso que falló. Sale con 1 si encontró alguna
+// diferencia que no sea una excepción documentada.
+
+#include "reference_engines.h"
+#include "cpusyncengine.h"
+#include "selectkernels.h"
+#include "syncengine.h"
+
+#include <QSet>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct CheckOptions {
+    int cases = 500;
+    unsigned seed = 1;
+    int maxProcesses = 60;      // La base recorre todos los procesos en cada ciclo
+    int maxActions = 120;
+    bool verbose = false;
+};
+
+// Se detiene después de unas cuantas diferencias; la primera suele bastar para depurar
+const int MAX_REPORTED = 5;
+
+struct Segment {
+    QString pid;
+    int start;
+    int length;
+    bool operator==(const Segment &other) const
+    {
+        return pid == other.pid && start == other.start && length == other.length;
+    }
+};
+
+bool parseOptions(int argc, char *argv[], CheckOptions &options)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--cases" && hasValue) options.cases = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--seed" && hasValue) options.seed = unsigned(std::strtoul(argv[++i], nullptr, 10));
+        else if (arg == "--max-processes" && hasValue) options.maxProcesses = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--max-actions" && hasValue) options.maxActions = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--verbose") options.verbose = true;
+        else {
+            std::fprintf(stderr, "Uso: %s [--cases N] [--seed N] [--max-processes N] [--max-actions N] [--verbose]\n", argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+int uniform(std::mt19937 &rng, int low, int high)
+{
+    return std::uniform_int_distribution<int>(low, high)(rng);
+}
+
+// Llegadas muy juntas (muchos empates) o dispersas (CPU ociosa), ráfagas de 0 a 12. En un
+// tercio de los casos no hay dos llegadas ni dos ráfagas iguales: FIFO, SJF y RR no tienen
+// empates y se comparan enteros.
+QVector<Proceso> randomProcesses(std::mt19937 &rng, int maxProcesses)
+{
+    int count = uniform(rng, 1, maxProcesses);
+    const int spreads[] = {0, count / 2, count * 2, count * 6};
+    int spread = spreads[uniform(rng, 0, 3)];
+    QVector<int> arrivals;
+    QVector<int> bursts;
+    if (uniform(rng, 0, 2) == 0) {
+        for (int t = 0; t < std::max(count, spread + 1); ++t) arrivals.append(t);
+        for (int b = 1; b <= count; ++b) bursts.append(b);
+        std::shuffle(arrivals.begin(), arrivals.end(), rng);
+        std::shuffle(bursts.begin(), bursts.end(), rng);
+    }
+
+    QVector<Proceso> procesos;
+    for (int i = 0; i < count; ++i) {
+        Proceso p;
+        p.PID = QString("P%1").arg(i);
+        p.BT = uniform(rng, 0, 19) == 0 ? 0 : uniform(rng, 1, 12);
+        p.AT = uniform(rng, 0, spread);
+        if (!arrivals.isEmpty()) {
+            p.BT = bursts[i];
+            p.AT = arrivals[i];
+        }
+        p.priority = uniform(rng, 0, 6);
+        procesos.append(p);
+    }
+    return procesos;
+}
+
+// SRT y Priority de la referencia no terminan con ráfagas 0 (excepción documentada)
+QVector<Proceso> withoutZeroBursts(QVector<Proceso> procesos)
+{
+    for (Proceso &p : procesos) p.BT = std::max(1, p.BT);
+    return procesos;
+}
+
+// Mezcla retenciones cortas con algunas que pasan del horizonte de la rueda de tiempo
+QVector<Action> randomActions(std::mt19937 &rng, int maxActions)
+{
+    int count = uniform(rng, 1, maxActions);
+    int processes = uniform(rng, 1, 8);
+    int resources = uniform(rng, 1, 4);
+    const int spans[] = {0, count / 4, count};
+    int span = spans[uniform(rng, 0, 2)];
+
+    QVector<Action> actions;
+    for (int i = 0; i < count; ++i) {
+        Action a;
+        a.PID = QString("P%1").arg(uniform(rng, 1, processes));
+        a.action = uniform(rng, 0, 2) == 0 ? "WRITE" : "READ";
+        a.resource = QString("R%1").arg(uniform(rng, 1, resources));
+        a.cycle = uniform(rng, 0, span);
+        a.holdCycles = uniform(rng, 0, 29) == 0 ? uniform(rng, 250, 600) : uniform(rng, 1, 4);
+        a.completed = false;
+        a.completionCycle = -1;
+        a.waitingSince = -1;
+        a.realWaitCycles = -1;
+        actions.append(a);
+    }
+    return actions;
+}
+
+// Lo que la ventana base sabe correr: retención de un ciclo y a lo sumo una acción por
+// proceso y ciclo, en mutex o semáforo. La base pone todos los semáforos en 1 antes de
+// correr, así que la capacidad es 1 y se despierta de a uno.
+QVector<Action> baselineActions(std::mt19937 &rng, int maxActions)
+{
+    QVector<Action> actions;
+    QSet<QString> used;
+    for (Action a : randomActions(rng, maxActions)) {
+        QString key = QString("%1@%2").arg(a.PID).arg(a.cycle);
+        if (used.contains(key)) continue;
+        used.insert(key);
+        a.holdCycles = 1;
+        actions.append(a);
+    }
+    return actions;
+}
+
+SyncConfig baselineConfig(std::mt19937 &rng, const QVector<Action> &actions)
+{
+    SyncConfig config;
+    config.mode = uniform(rng, 0, 1) == 0 ? SyncMode::Mutex : SyncMode::Semaphore;
+    config.defaultWakeup = WakeupPolicy::WakeOne;
+    for (const Action &a : actions) config.capacity.insert(a.resource, 1);
+    return config;
+}
+
+SyncConfig randomConfig(std::mt19937 &rng, const QVector<Action> &actions)
+{
+    SyncConfig config;
+    config.mode = SyncMode(uniform(rng, 0, 2));
+    config.rwPolicy = RwPolicy(uniform(rng, 0, 2));
+    config.defaultWakeup = uniform(rng, 0, 1) == 0 ? WakeupPolicy::WakeOne : WakeupPolicy::WakeAll;
+    for (const Action &a : actions) {
+        if (config.capacity.contains(a.resource)) continue;
+        // Un recurso sin permisos deja acciones pendientes para siempre
+        config.capacity.insert(a.resource, uniform(rng, 0, 9) == 0 ? 0 : uniform(rng, 1, 3));
+        if (uniform(rng, 0, 2) == 0) {
+            config.resourcePolicies.insert(a.resource, uniform(rng, 0, 1) == 0 ? WakeupPolicy::WakeOne : WakeupPolicy::WakeAll);
+        }
+    }
+    return config;
+}
+
+QVector<Segment> mergeSegments(const QVector<ResultadoSimulacion> &segments)
+{
+    QVector<Segment> merged;
+    for (const ResultadoSimulacion &s : segments) {
+        if (s.duracion <= 0) continue;
+        if (!merged.isEmpty() && merged.last().pid == s.PID && merged.last().start + merged.last().length == s.inicio) {
+            merged.last().length += s.duracion;
+        } else {
+            merged.append({s.PID, s.inicio, s.duracion});
+        }
+    }
+    return merged;
+}
+
+QVector<Segment> timelineSegments(const Timeline &timeline)
+{
+    QVector<Segment> segments;
+    timeline.forEach([&](const Timeline::Segment &s) { segments.append({timeline.name(s.owner), s.start, s.length}); });
+    return segments;
+}
+
+void printProcesses(const QVector<Proceso> &procesos)
+{
+    for (const Proceso &p : procesos) {
+        std::fprintf(stderr, "    %s,%d,%d,%d\n", qPrintable(p.PID), p.BT, p.AT, p.priority);
+    }
+}
+
+void printActions(const QVector<Action> &actions)
+{
+    for (const Action &a : actions) {
+        std::fprintf(stderr, "    %s,%s,%s,%d,%d\n", qPrintable(a.PID), qPrintable(a.action),
+                     qPrintable(a.resource), a.cycle, a.holdCycles);
+    }
+}
+
+// Dueño de cada ciclo, vacío si la CPU está ociosa
+QVector<QString> cycleOwners(const QVector<Segment> &segments)
+{
+    QVector<QString> owners;
+    for (const Segment &s : segments) {
+        while (owners.size() < s.start) owners.append(QString());
+        for (int k = 0; k < s.length; ++k) owners.append(s.pid);
+    }
+    return owners;
+}
+
+// Clave de la política para un proceso en el ciclo `cycle`, con `ran` ciclos ya corridos;
+// menor es mejor. El aging es el de la base: uno cada `aging` ciclos desde la llegada.
+int policyKey(SchedulingAlgorithm algorithm, const Proceso &p, int ran, int cycle, int aging)
+{
+    switch (algorithm) {
+    case SchedulingAlgorithm::SJF:
+        return p.BT;
+    case SchedulingAlgorithm::SRT:
+        return p.BT - ran;
+    case SchedulingAlgorithm::PriorityAging: {
+        int priority = p.priority;
+        for (int k = (cycle - p.AT) / aging; k > 0 && priority != 1; --k) priority = std::max(1, priority - 1);
+        return priority;
+    }
+    default:
+        return p.AT;
+    }
+}
+
+enum class Outcome { Same, Tie, Different };
+
+// Compara un algoritmo y describe la primera diferencia. Si en ese ciclo los dos lados
+// eligieron procesos listos con la misma clave, es un empate documentado. Suma a
+// `compared` los ciclos que coinciden antes de separarse y a `total` los de la referencia.
+Outcome checkCpu(const QString &name, const QVector<Proceso> &procesos, SchedulingAlgorithm algorithm,
+                 const QVector<ResultadoSimulacion> &expected, int quantum, int aging, QString &detail,
+                 long long &compared, long long &total)
+{
+    CpuSyncConfig config;
+    config.algorithm = algorithm;
+    config.quantum = quantum;
+    config.agingInterval = aging;
+    QVector<Segment> actual = timelineSegments(simulateCpuWithBlocking(procesos, QVector<Action>(), config).timeline);
+    QVector<Segment> reference = mergeSegments(expected);
+    QVector<QString> right = cycleOwners(reference);
+    total += right.size();
+    if (actual == reference) {
+        compared += right.size();
+        return Outcome::Same;
+    }
+
+    QVector<QString> left = cycleOwners(actual);
+    int cycle = 0;
+    while (cycle < left.size() && cycle < right.size() && left[cycle] == right[cycle]) cycle++;
+    compared += cycle;
+    QString mine = cycle < left.size() && !left[cycle].isEmpty() ? left[cycle] : "ociosa";
+    QString theirs = cycle < right.size() && !right[cycle].isEmpty() ? right[cycle] : "ociosa";
+    detail = QString("%1 (Q=%2, T=%3): ciclo %4, optimizado %5, referencia %6")
+                 .arg(name).arg(quantum).arg(aging).arg(cycle).arg(mine, theirs);
+
+    const Proceso *a = nullptr;
+    const Proceso *b = nullptr;
+    for (const Proceso &p : procesos) {
+        if (p.PID == mine) a = &p;
+        if (p.PID == theirs) b = &p;
+    }
+    if (!a || !b || a->AT > cycle || b->AT > cycle) return Outcome::Different;
+    // Hasta `cycle` las dos corridas son iguales, así que lo corrido se cuenta en una
+    int ranA = 0;
+    int ranB = 0;
+    for (int t = 0; t < cycle; ++t) {
+        if (right[t] == mine) ranA++;
+        if (right[t] == theirs) ranB++;
+    }
+    int keyA = policyKey(algorithm, *a, ranA, cycle, aging);
+    int keyB = policyKey(algorithm, *b, ranB, cycle, aging);
+    if (keyA != keyB) return Outcome::Different;
+    detail += QString(", empate en %1").arg(keyA);
+    return Outcome::Tie;
+}
+
+const char *kindName(SyncEventKind kind)
+{
+    switch (kind) {
+    case SyncEventKind::Accessed: return "ACCESSED";
+    case SyncEventKind::AccessedFromQueue: return "ACCESSED desde cola";
+    case SyncEventKind::Waiting: return "WAITING";
+    }
+    return "?";
+}
+
+QString describeEvents(const QVector<SyncEvent> &events)
+{
+    QStringList parts;
+    for (const SyncEvent &e : events) parts << QString("%1:%2").arg(e.action).arg(kindName(e.kind));
+    return parts.join(" ");
+}
+
+bool sameEvents(const QVector<SyncEvent> &a, const QVector<SyncEvent> &b)
+{
+    if (a.size() != b.size()) return false;
+    for (int i = 0; i < a.size(); ++i) {
+        if (a[i].cycle != b[i].cycle || a[i].action != b[i].action || a[i].kind != b[i].kind) return false;
+    }
+    return true;
+}
+
+bool sameActions(const QVector<Action> &a, const QVector<Action> &b, QString &detail)
+{
+    if (a.size() != b.size()) {
+        detail = QString("%1 contra %2 acciones").arg(a.size()).arg(b.size());
+        return false;
+    }
+    for (int i = 0; i < a.size(); ++i) {
+        if (a[i].PID == b[i].PID && a[i].resource == b[i].resource && a[i].cycle == b[i].cycle &&
+            a[i].completed == b[i].completed && a[i].completionCycle == b[i].completionCycle &&
+            a[i].waitingSince == b[i].waitingSince) {
+            continue;
+        }
+        detail = QString("acción %1 (%2 %3 ciclo %4): acceso %5 contra %6, espera desde %7 contra %8")
+                     .arg(i).arg(a[i].PID, a[i].resource).arg(a[i].cycle)
+                     .arg(a[i].completionCycle).arg(b[i].completionCycle)
+                     .arg(a[i].waitingSince).arg(b[i].waitingSince);
+        return false;
+    }
+    return true;
+}
+
+// Avanza el motor y la ventana base en paralelo; devuelve false y describe la primera diferencia
+bool checkSync(const SyncConfig &config, const QVector<Action> &actions, QString &detail)
+{
+    SyncEngine optimized(config, false);
+    reference::SyncEngine expected(config);
+    optimized.load(actions);
+    expected.load(actions);
+
+    QStringList resources = config.capacity.keys();
+    // Con acciones desde el ciclo 0 y retenciones de un ciclo ninguna corrida llega tan lejos
+    const int cycleLimit = 1000000;
+    bool expectedDone = false;
+    bool optimizedDone = false;
+    while (!expectedDone) {
+        int cycle = expected.cycle();
+        expectedDone = expected.step();
+        optimizedDone = optimized.step();
+
+        if (optimized.cycle() != cycle) {
+            detail = QString("ciclo %1 contra %2").arg(optimized.cycle()).arg(cycle);
+            return false;
+        }
+        if (!sameEvents(optimized.lastEvents(), expected.lastEvents())) {
+            detail = QString("ciclo %1: eventos [%2] contra [%3]").arg(cycle)
+                         .arg(describeEvents(optimized.lastEvents()), describeEvents(expected.lastEvents()));
+            return false;
+        }
+        for (const QString &resource : resources) {
+            QVector<int> a = optimized.waitingActions(resource);
+            QVector<int> b = expected.waitingActions(resource);
+            if (a == b) continue;
+            QStringList left, right;
+            for (int i : a) left << QString::number(i);
+            for (int i : b) right << QString::number(i);
+            detail = QString("ciclo %1: cola de %2 [%3] contra [%4]").arg(cycle).arg(resource)
+                         .arg(left.join(" "), right.join(" "));
+            return false;
+        }
+        if (optimizedDone && !expectedDone) {
+            detail = QString("ciclo %1: el optimizado ya terminó").arg(cycle);
+            return false;
+        }
+        if (cycle > cycleLimit) {
+            detail = "la corrida no termina";
+            return false;
+        }
+    }
+
+    // La base termina con la última concesión; el optimizado, al soltar esa retención un
+    // ciclo después (excepción documentada). Ese ciclo no puede conceder nada.
+    if (!optimizedDone) {
+        optimizedDone = optimized.step();
+        if (!optimizedDone || !optimized.lastEvents().isEmpty()) {
+            detail = QString("ciclo %1: el optimizado sigue después del fin de la base").arg(optimized.cycle());
+            return false;
+        }
+    }
+    return sameActions(optimized.results(), expected.results(), detail);
+}
+
+// La corrida fragmentada por recurso contra la serial, con todos los modos y políticas
+bool checkSharded(const SyncConfig &config, const QVector<Action> &actions, QString &detail)
+{
+    SyncEngine engine(config, false);
+    engine.load(actions);
+    SyncRunResult serial = engine.runToCompletion();
+    SyncRunResult sharded = runShardedSimulation(config, actions, 4);
+    if (!sameActions(sharded.actions, serial.actions, detail)) return false;
+    if (sharded.finalCycle != serial.finalCycle || sharded.allCompleted != serial.allCompleted) {
+        detail = QString("termina en %1 contra %2").arg(sharded.finalCycle).arg(serial.finalCycle);
+        return false;
+    }
+    return true;
+}
+
+const char *modeName(SyncMode mode)
+{
+    switch (mode) {
+    case SyncMode::Mutex: return "mutex";
+    case SyncMode::Semaphore: return "semáforo";
+    case SyncMode::ReaderWriter: return "lector-escritor";
+    }
+    return "?";
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    CheckOptions options;
+    if (!parseOptions(argc, argv, options)) return 1;
+
+    std::printf("Kernel de selección: %s\n", selectKernelName());
+    int failures = 0;
+    int ties = 0;
+    long long cpuRuns = 0;
+    long long cpuCompared = 0;
+    long long cpuCycles = 0;
+    long long syncRuns = 0;
+    double cpuMs = 0;
+    double syncMs = 0;
+
+    for (int c = 0; c < options.cases && failures < MAX_REPORTED; ++c) {
+        unsigned seed = options.seed + unsigned(c);
+        std::mt19937 rng(seed);
+
+        // CPU
+        auto start = Clock::now();
+        QVector<Proceso> procesos = randomProcesses(rng, options.maxProcesses);
+        QVector<Proceso> positive = withoutZeroBursts(procesos);
+        int quantum = uniform(rng, 1, 4);
+        int aging = uniform(rng, 1, 6);
+        struct Run {
+            const char *name;
+            SchedulingAlgorithm algorithm;
+            const QVector<Proceso> &procesos;
+            QVector<ResultadoSimulacion> expected;
+        };
+        const Run runs[] = {
+            {"FIFO", SchedulingAlgorithm::FIFO, procesos, reference::ejecutarFIFO(procesos)},
+            {"SJF", SchedulingAlgorithm::SJF, procesos, reference::ejecutarSJF(procesos)},
+            {"SRT", SchedulingAlgorithm::SRT, positive, reference::ejecutarSRT(positive)},
+            {"RR", SchedulingAlgorithm::RoundRobin, procesos, reference::ejecutarRR(procesos, quantum)},
+            {"Priority", SchedulingAlgorithm::PriorityAging, positive, reference::ejecutarPriorityAging(positive, aging)},
+        };
+        for (const Run &run : runs) {
+            QString detail;
+            cpuRuns++;
+            Outcome outcome = checkCpu(run.name, run.procesos, run.algorithm, run.expected, quantum, aging, detail,
+                                       cpuCompared, cpuCycles);
+            if (outcome == Outcome::Same) continue;
+            if (outcome == Outcome::Tie) {
+                ties++;
+                if (options.verbose) std::printf("Empate, semilla %u: %s\n", seed, qPrintable(detail));
+                continue;
+            }
+            failures++;
+            std::fprintf(stderr, "DIFERENCIA CPU, semilla %u: %s\n", seed, qPrintable(detail));
+            if (options.verbose) printProcesses(run.procesos);
+        }
+        cpuMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        // Sincronización: contra la base y, con todos los modos, fragmentada contra serial
+        start = Clock::now();
+        QVector<Action> actions = baselineActions(rng, options.maxActions);
+        SyncConfig config = baselineConfig(rng, actions);
+        QVector<Action> anyActions = randomActions(rng, options.maxActions);
+        SyncConfig anyConfig = randomConfig(rng, anyActions);
+        QString detail;
+        syncRuns += 2;
+        if (!checkSync(config, actions, detail)) {
+            failures++;
+            std::fprintf(stderr, "DIFERENCIA sincronización (%s), semilla %u: %s\n",
+                         modeName(config.mode), seed, qPrintable(detail));
+            if (options.verbose) printActions(actions);
+        }
+        if (!checkSharded(anyConfig, anyActions, detail)) {
+            failures++;
+            std::fprintf(stderr, "DIFERENCIA fragmentada (%s), semilla %u: %s\n",
+                         modeName(anyConfig.mode), seed, qPrintable(detail));
+            if (options.verbose) printActions(anyActions);
+        }
+        syncMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    // Un empate corta la comparación de esa corrida; el porcentaje dice cuánto se comparó
+    std::printf("CPU: %lld corridas en %.1f ms, %d cortadas por empates documentados, %.1f%% de los ciclos comparados\n",
+                cpuRuns, cpuMs, ties, cpuCycles > 0 ? 100.0 * double(cpuCompared) / double(cpuCycles) : 100.0);
+    std::printf("Sincronización: %lld corridas en %.1f ms\n", syncRuns, syncMs);
+    std::printf("%d diferencias\n", failures);
+    return failures == 0 ? 0 : 1;
+}
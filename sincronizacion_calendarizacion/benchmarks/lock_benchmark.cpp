@@ -0,0 +1,280 @@
+// Benchmark de primitivas de sincronización guiado por trazas de acciones.
+//
+// Uso: lock_benchmark [acciones.txt] [--resources recursos.txt] [--ms N] [--work N] [--max-threads N] [--csv]
+//
+// Reproduce la traza (mismo formato que el simulador: PID, ACCION, RECURSO, CICLO[, DURACION])
+// con 1, 2, 4, ... hilos hasta el número de núcleos. Cada hilo recorre la traza completa
+// desde un desplazamiento distinto, toma el candado del recurso de cada acción, trabaja
+// DURACION * work iteraciones dentro de la sección crítica y lo libera.
+// Reporta throughput, latencia p99 de adquisición y el índice de equidad de Jain.
+
+#include "locks.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <latch>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct TraceAction {
+    int resource;
+    int holdCycles;
+};
+
+struct Trace {
+    std::vector<TraceAction> actions;
+    std::vector<int> permits;           // Permisos por recurso
+    std::vector<std::string> resources;
+};
+
+struct BenchOptions {
+    std::string actionsPath = "sync_example_files/acciones.txt";
+    std::string resourcesPath;
+    int durationMs = 200;
+    int workPerCycle = 100;
+    int maxThreads = 0;
+    bool csv = false;
+};
+
+struct BenchResult {
+    double opsPerSecond = 0.0;
+    double p99AcquireNs = 0.0;
+    double fairness = 0.0;
+};
+
+std::string trim(const std::string &text)
+{
+    size_t first = text.find_first_not_of(" \t\r\n");
+    if (first == std::string::npos) return "";
+    size_t last = text.find_last_not_of(" \t\r\n");
+    return text.substr(first, last - first + 1);
+}
+
+std::vector<std::string> splitFields(const std::string &line)
+{
+    std::vector<std::string> fields;
+    std::stringstream stream(line);
+    std::string field;
+    while (std::getline(stream, field, ',')) {
+        field = trim(field);
+        if (!field.empty()) fields.push_back(field);
+    }
+    return fields;
+}
+
+bool loadTrace(const BenchOptions &options, Trace &trace)
+{
+    std::map<std::string, int> permitsByName;
+    if (!options.resourcesPath.empty()) {
+        std::ifstream resources(options.resourcesPath);
+        if (!resources) {
+            std::fprintf(stderr, "No se pudo abrir %s\n", options.resourcesPath.c_str());
+            return false;
+        }
+        std::string line;
+        while (std::getline(resources, line)) {
+            std::vector<std::string> fields = splitFields(line);
+            if (fields.size() >= 2) permitsByName[fields[0]] = std::atoi(fields[1].c_str());
+        }
+    }
+
+    std::ifstream file(options.actionsPath);
+    if (!file) {
+        std::fprintf(stderr, "No se pudo abrir %s\n", options.actionsPath.c_str());
+        return false;
+    }
+
+    struct Row { int cycle; TraceAction action; };
+    std::vector<Row> rows;
+    std::map<std::string, int> resourceIndex;
+    std::string line;
+    while (std::getline(file, line)) {
+        std::vector<std::string> fields = splitFields(line);
+        if (fields.size() != 4 && fields.size() != 5) continue;
+
+        auto found = resourceIndex.find(fields[2]);
+        if (found == resourceIndex.end()) {
+            found = resourceIndex.emplace(fields[2], int(trace.resources.size())).first;
+            trace.resources.push_back(fields[2]);
+            auto permits = permitsByName.find(fields[2]);
+            trace.permits.push_back(permits != permitsByName.end() ? permits->second : 1);
+        }
+
+        int hold = fields.size() == 5 ? std::max(1, std::atoi(fields[4].c_str())) : 1;
+        rows.push_back({std::atoi(fields[3].c_str()), {found->second, hold}});
+    }
+
+    // Reproducir en orden de ciclo, como el simulador
+    std::stable_sort(rows.begin(), rows.end(), [](const Row &a, const Row &b) {
+        return a.cycle < b.cycle;
+    });
+    for (const Row &row : rows) trace.actions.push_back(row.action);
+
+    return !trace.actions.empty();
+}
+
+// Trabajo dentro de la sección crítica; volatile para que no se elimine
+void criticalWork(int iterations)
+{
+    volatile unsigned sink = 0;
+    for (int i = 0; i < iterations; ++i) sink = sink + i;
+}
+
+double jainIndex(const std::vector<long long> &counts)
+{
+    double sum = 0.0;
+    double sumSquares = 0.0;
+    for (long long count : counts) {
+        sum += count;
+        sumSquares += double(count) * count;
+    }
+    return sumSquares > 0 ? (sum * sum) / (counts.size() * sumSquares) : 0.0;
+}
+
+template <typename LockT>
+BenchResult runBenchmark(const Trace &trace, int threadCount, const BenchOptions &options)
+{
+    std::vector<std::unique_ptr<LockT>> locks;
+    for (int permits : trace.permits) locks.push_back(std::make_unique<LockT>(permits));
+
+    const size_t maxSamples = 1 << 18;
+    std::vector<std::vector<double>> latencies(threadCount);
+    std::vector<long long> operations(threadCount, 0);
+    std::atomic<bool> stop{false};
+    std::latch ready(threadCount + 1);
+
+    auto worker = [&](int id) {
+        LockNode node;
+        std::vector<double> &samples = latencies[id];
+        samples.reserve(maxSamples);
+        size_t position = (trace.actions.size() * id) / threadCount;
+        long long done = 0;
+
+        ready.arrive_and_wait();
+        while (!stop.load(std::memory_order_relaxed)) {
+            const TraceAction &action = trace.actions[position];
+            LockT &lock = *locks[action.resource];
+
+            Clock::time_point requested = Clock::now();
+            lock.lock(node);
+            Clock::time_point acquired = Clock::now();
+            criticalWork(action.holdCycles * options.workPerCycle);
+            lock.unlock(node);
+
+            if (samples.size() < maxSamples) {
+                samples.push_back(std::chrono::duration<double, std::nano>(acquired - requested).count());
+            }
+            done++;
+            if (++position == trace.actions.size()) position = 0;
+        }
+        operations[id] = done;
+    };
+
+    std::vector<std::thread> threads;
+    for (int id = 0; id < threadCount; ++id) threads.emplace_back(worker, id);
+
+    ready.arrive_and_wait();
+    Clock::time_point start = Clock::now();
+    std::this_thread::sleep_for(std::chrono::milliseconds(options.durationMs));
+    stop.store(true);
+    for (std::thread &thread : threads) thread.join();
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<double> all;
+    for (const auto &samples : latencies) all.insert(all.end(), samples.begin(), samples.end());
+
+    BenchResult result;
+    long long total = 0;
+    for (long long count : operations) total += count;
+    result.opsPerSecond = total / seconds;
+    if (!all.empty()) {
+        size_t index = std::min(all.size() - 1, all.size() * 99 / 100);
+        std::nth_element(all.begin(), all.begin() + index, all.end());
+        result.p99AcquireNs = all[index];
+    }
+    result.fairness = jainIndex(operations);
+    return result;
+}
+
+template <typename LockT>
+void sweep(const Trace &trace, const std::vector<int> &threadCounts, const BenchOptions &options)
+{
+    for (int threads : threadCounts) {
+        BenchResult result = runBenchmark<LockT>(trace, threads, options);
+        if (options.csv) {
+            std::printf("%s,%d,%.0f,%.0f,%.4f\n", LockT::name(), threads,
+                        result.opsPerSecond, result.p99AcquireNs, result.fairness);
+        } else {
+            std::printf("%-14s %7d %14.0f %14.0f %9.4f\n", LockT::name(), threads,
+                        result.opsPerSecond, result.p99AcquireNs, result.fairness);
+        }
+        std::fflush(stdout);
+    }
+}
+
+bool parseOptions(int argc, char *argv[], BenchOptions &options)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--resources" && hasValue) options.resourcesPath = argv[++i];
+        else if (arg == "--ms" && hasValue) options.durationMs = std::atoi(argv[++i]);
+        else if (arg == "--work" && hasValue) options.workPerCycle = std::atoi(argv[++i]);
+        else if (arg == "--max-threads" && hasValue) options.maxThreads = std::atoi(argv[++i]);
+        else if (arg == "--csv") options.csv = true;
+        else if (!arg.empty() && arg[0] != '-') options.actionsPath = arg;
+        else {
+            std::fprintf(stderr, "Uso: %s [acciones.txt] [--resources recursos.txt] [--ms N] "
+                                 "[--work N] [--max-threads N] [--csv]\n", argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    BenchOptions options;
+    if (!parseOptions(argc, argv, options)) return 1;
+
+    Trace trace;
+    if (!loadTrace(options, trace)) {
+        std::fprintf(stderr, "La traza de acciones está vacía o no se pudo leer\n");
+        return 1;
+    }
+
+    int cores = int(std::thread::hardware_concurrency());
+    int maxThreads = options.maxThreads > 0 ? options.maxThreads : std::max(1, cores);
+    std::vector<int> threadCounts;
+    for (int threads = 1; threads < maxThreads; threads *= 2) threadCounts.push_back(threads);
+    threadCounts.push_back(maxThreads);
+
+    if (options.csv) {
+        std::printf("lock,threads,ops_per_sec,p99_acquire_ns,fairness\n");
+    } else {
+        std::printf("Traza: %s (%zu acciones, %zu recursos), %d ms por configuración\n\n",
+                    options.actionsPath.c_str(), trace.actions.size(), trace.resources.size(),
+                    options.durationMs);
+        std::printf("%-14s %7s %14s %14s %9s\n", "candado", "hilos", "ops/s", "p99 adq (ns)", "Jain");
+    }
+
+    sweep<StdMutexLock>(trace, threadCounts, options);
+    sweep<FutexLock>(trace, threadCounts, options);
+    sweep<TtasSpinLock>(trace, threadCounts, options);
+    sweep<TicketLock>(trace, threadCounts, options);
+    sweep<McsLock>(trace, threadCounts, options);
+    sweep<SemaphoreLock>(trace, threadCounts, options);
+    return 0;
+}
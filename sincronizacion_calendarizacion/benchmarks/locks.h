@@ -0,0 +1,190 @@
+#ifndef LOCKS_H
+#define LOCKS_H
+
+#include <atomic>
+#include <mutex>
+#include <semaphore>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+// Implementaciones de candados para el benchmark de primitivas.
+// Todas comparten la misma interfaz lock(LockNode&)/unlock(LockNode&): el nodo solo
+// lo usa el candado MCS, los demás lo ignoran. El constructor recibe los permisos
+// del recurso, que solo usa el semáforo.
+
+inline void cpuRelax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#else
+    std::this_thread::yield();
+#endif
+}
+
+// Nodo por hilo de la cola MCS
+struct alignas(64) LockNode {
+    std::atomic<LockNode*> next{nullptr};
+    std::atomic<bool> locked{false};
+};
+
+class StdMutexLock
+{
+public:
+    explicit StdMutexLock(int = 1) {}
+    void lock(LockNode &) { mutex.lock(); }
+    void unlock(LockNode &) { mutex.unlock(); }
+    static const char *name() { return "std::mutex"; }
+
+private:
+    std::mutex mutex;
+};
+
+// Mutex de tres estados sobre futex (0 libre, 1 tomado, 2 tomado con esperas)
+class FutexLock
+{
+public:
+    explicit FutexLock(int = 1) {}
+
+    void lock(LockNode &)
+    {
+        int expected = 0;
+        if (state.compare_exchange_strong(expected, 1, std::memory_order_acquire)) return;
+        if (expected != 2) expected = state.exchange(2, std::memory_order_acquire);
+        while (expected != 0) {
+            wait(2);
+            expected = state.exchange(2, std::memory_order_acquire);
+        }
+    }
+
+    void unlock(LockNode &)
+    {
+        if (state.exchange(0, std::memory_order_release) == 2) wakeOne();
+    }
+
+    static const char *name() { return "futex"; }
+
+private:
+    void wait(int value)
+    {
+#if defined(__linux__)
+        syscall(SYS_futex, reinterpret_cast<int*>(&state), FUTEX_WAIT_PRIVATE, value, nullptr, nullptr, 0);
+#else
+        state.wait(value, std::memory_order_relaxed);
+#endif
+    }
+
+    void wakeOne()
+    {
+#if defined(__linux__)
+        syscall(SYS_futex, reinterpret_cast<int*>(&state), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+#else
+        state.notify_one();
+#endif
+    }
+
+    static_assert(sizeof(std::atomic<int>) == sizeof(int), "futex requiere un atomic<int> sin relleno");
+    std::atomic<int> state{0};
+};
+
+// Spinlock test-and-test-and-set: solo intenta el intercambio cuando lo ve libre
+class TtasSpinLock
+{
+public:
+    explicit TtasSpinLock(int = 1) {}
+
+    void lock(LockNode &)
+    {
+        for (;;) {
+            if (!locked.exchange(true, std::memory_order_acquire)) return;
+            while (locked.load(std::memory_order_relaxed)) cpuRelax();
+        }
+    }
+
+    void unlock(LockNode &) { locked.store(false, std::memory_order_release); }
+    static const char *name() { return "TTAS spinlock"; }
+
+private:
+    std::atomic<bool> locked{false};
+};
+
+// Ticket lock: orden FIFO estricto entre los hilos que esperan
+class TicketLock
+{
+public:
+    explicit TicketLock(int = 1) {}
+
+    void lock(LockNode &)
+    {
+        unsigned ticket = nextTicket.fetch_add(1, std::memory_order_relaxed);
+        while (nowServing.load(std::memory_order_acquire) != ticket) cpuRelax();
+    }
+
+    void unlock(LockNode &)
+    {
+        nowServing.store(nowServing.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    static const char *name() { return "ticket"; }
+
+private:
+    alignas(64) std::atomic<unsigned> nextTicket{0};
+    alignas(64) std::atomic<unsigned> nowServing{0};
+};
+
+// Cola MCS: cada hilo gira sobre su propio nodo, sin tráfico en una línea compartida
+class McsLock
+{
+public:
+    explicit McsLock(int = 1) {}
+
+    void lock(LockNode &node)
+    {
+        node.next.store(nullptr, std::memory_order_relaxed);
+        node.locked.store(true, std::memory_order_relaxed);
+        LockNode *previous = tail.exchange(&node, std::memory_order_acq_rel);
+        if (previous) {
+            previous->next.store(&node, std::memory_order_release);
+            while (node.locked.load(std::memory_order_acquire)) cpuRelax();
+        }
+    }
+
+    void unlock(LockNode &node)
+    {
+        LockNode *successor = node.next.load(std::memory_order_acquire);
+        if (!successor) {
+            LockNode *expected = &node;
+            if (tail.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel)) return;
+            while (!(successor = node.next.load(std::memory_order_acquire))) cpuRelax();
+        }
+        successor->locked.store(false, std::memory_order_release);
+    }
+
+    static const char *name() { return "MCS"; }
+
+private:
+    std::atomic<LockNode*> tail{nullptr};
+};
+
+// Semáforo contador con los permisos del recurso (1 si no hay archivo de recursos)
+class SemaphoreLock
+{
+public:
+    explicit SemaphoreLock(int permits = 1) : semaphore(permits > 0 ? permits : 1) {}
+    void lock(LockNode &) { semaphore.acquire(); }
+    void unlock(LockNode &) { semaphore.release(); }
+    static const char *name() { return "semaphore"; }
+
+private:
+    std::counting_semaphore<> semaphore;
+};
+
+#endif // LOCKS_H
@@ -0,0 +1,476 @@
+#include "reference_engines.h"
+#include <QQueue>
+#include <algorithm>
+
+namespace reference {
+
+QVector<ResultadoSimulacion> ejecutarFIFO(const QVector<Proceso>& procesosOriginales) {
+    QVector<Proceso> procesos = procesosOriginales;
+    QVector<ResultadoSimulacion> resultado;
+
+    std::sort(procesos.begin(), procesos.end(), [](const Proceso &a, const Proceso &b) {
+        return a.AT < b.AT;
+    });
+
+    int tiempoActual = 0;
+    for (const Proceso &p : procesos) {
+        if (tiempoActual < p.AT)
+            tiempoActual = p.AT;
+
+        resultado.append({p.PID, tiempoActual, p.BT});
+        tiempoActual += p.BT;
+    }
+
+    return resultado;
+}
+
+QVector<ResultadoSimulacion> ejecutarSJF(const QVector<Proceso>& procesosOriginales) {
+    QVector<Proceso> procesos = procesosOriginales;
+    QVector<ResultadoSimulacion> resultado;
+
+    int tiempoActual = 0;
+    QVector<Proceso> procesosPendientes = procesos;
+    QVector<Proceso> disponibles;
+
+    while (!procesosPendientes.isEmpty()) {
+        // Obtener todos los procesos que han llegado hasta el tiempo actual
+        disponibles.clear();
+        for (int i = 0; i < procesosPendientes.size(); ++i) {
+            if (procesosPendientes[i].AT <= tiempoActual) {
+                disponibles.append(procesosPendientes[i]);
+            }
+        }
+
+        if (!disponibles.isEmpty()) {
+            // Elegir el proceso con menor tiempo de burst
+            std::sort(disponibles.begin(), disponibles.end(), [](const Proceso &a, const Proceso &b) {
+                return a.BT < b.BT;
+            });
+
+            Proceso elegido = disponibles.first();
+
+            // Agregar al resultado
+            resultado.append({elegido.PID, tiempoActual, elegido.BT});
+            tiempoActual += elegido.BT;
+
+            // Eliminar el proceso elegido de los pendientes
+            for (int i = 0; i < procesosPendientes.size(); ++i) {
+                if (procesosPendientes[i].PID == elegido.PID) {
+                    procesosPendientes.removeAt(i);
+                    break;
+                }
+            }
+        } else {
+            // No hay procesos listos aún, avanzar el tiempo
+            tiempoActual++;
+        }
+    }
+
+    return resultado;
+}
+
+QVector<ResultadoSimulacion> ejecutarSRT(const QVector<Proceso>& procesosOriginales) {
+    QVector<ResultadoSimulacion> resultado;
+    QVector<Proceso> procesosPendientes = procesosOriginales;
+
+    int tiempoActual = 0;
+    Proceso* procesoActual = nullptr;
+    QMap<QString, int> tiempoRestante;
+    QMap<QString, Proceso*> procesoMap;  // Mapa para búsqueda rápida
+
+    // Inicializar estructuras
+    for (auto& proceso : procesosPendientes) {
+        tiempoRestante[proceso.PID] = proceso.BT;
+        procesoMap[proceso.PID] = &proceso;
+    }
+
+    while (!tiempoRestante.isEmpty()) {
+        // Recolectar procesos disponibles
+        QVector<Proceso*> disponibles;
+        for (auto it = tiempoRestante.begin(); it != tiempoRestante.end(); ++it) {
+            Proceso* proc = procesoMap[it.key()];
+            if (proc->AT <= tiempoActual && it.value() > 0) {
+                disponibles.append(proc);
+            }
+        }
+
+        if (!disponibles.isEmpty()) {
+            // Ordenar por tiempo restante
+            std::sort(disponibles.begin(), disponibles.end(), [&](Proceso* a, Proceso* b) {
+                return tiempoRestante[a->PID] < tiempoRestante[b->PID];
+            });
+
+            Proceso* elegido = disponibles.first();
+
+            // Manejar cambio de proceso
+            if (!procesoActual || procesoActual->PID != elegido->PID) {
+                resultado.append({elegido->PID, tiempoActual, 1});
+            } else {
+                resultado.last().duracion++;
+            }
+
+            procesoActual = elegido;
+            tiempoRestante[elegido->PID]--;
+
+            // Eliminar si terminó
+            if (tiempoRestante[elegido->PID] == 0) {
+
+                tiempoRestante.remove(elegido->PID);
+            }
+
+        }
+
+        tiempoActual++;
+    }
+
+    return resultado;
+}
+
+QVector<ResultadoSimulacion> ejecutarRR(const QVector<Proceso>& procesosOriginales, int quantum) {
+    QVector<ResultadoSimulacion> resultado;
+    QVector<Proceso> procesos = procesosOriginales;
+    QMap<QString, int> tiempoRestante;
+    QQueue<Proceso*> colaListos;
+    int tiempoActual = 0;
+
+    // Inicializar tiempo restante
+    for (const auto& p : procesos) {
+        tiempoRestante[p.PID] = p.BT;
+    }
+
+    // Ordenar procesos por tiempo de llegada
+    std::sort(procesos.begin(), procesos.end(), [](const Proceso& a, const Proceso& b) {
+        return a.AT < b.AT;
+    });
+
+    // Índice para nuevos procesos que llegan
+    int nextProceso = 0;
+
+    while (true) {
+        // Agregar procesos que han llegado a la cola de listos
+        while (nextProceso < procesos.size() && procesos[nextProceso].AT <= tiempoActual) {
+            colaListos.enqueue(&procesos[nextProceso]);
+            nextProceso++;
+        }
+
+        if (colaListos.isEmpty()) {
+            if (nextProceso < procesos.size()) {
+                // No hay procesos listos, avanzar al próximo tiempo de llegada
+                tiempoActual = procesos[nextProceso].AT;
+                continue;
+            } else {
+                // Todos los procesos completados
+                break;
+            }
+        }
+
+        Proceso* actual = colaListos.dequeue();
+        int tiempoEjecucion = qMin(quantum, tiempoRestante[actual->PID]);
+
+        // Registrar el segmento de ejecución
+        resultado.append({actual->PID, tiempoActual, tiempoEjecucion});
+
+        // Actualizar tiempo restante
+        tiempoRestante[actual->PID] -= tiempoEjecucion;
+        tiempoActual += tiempoEjecucion;
+
+        // Agregar procesos que llegaron durante esta ejecución
+        while (nextProceso < procesos.size() && procesos[nextProceso].AT < tiempoActual) {
+            colaListos.enqueue(&procesos[nextProceso]);
+            nextProceso++;
+        }
+
+        // Si el proceso no ha terminado, volver a colocarlo en la cola
+        if (tiempoRestante[actual->PID] > 0) {
+            colaListos.enqueue(actual);
+        }
+    }
+
+    return resultado;
+}
+
+QVector<ResultadoSimulacion> ejecutarPriorityAging(const QVector<Proceso>& procesosOriginales, int intervaloAging) {
+    QVector<ResultadoSimulacion> resultado;
+    QVector<Proceso> procesos = procesosOriginales;
+    std::sort(procesos.begin(), procesos.end(), [](const Proceso& a, const Proceso& b) {
+        return a.AT < b.AT; // Ordenar por tiempo de llegada inicial
+    });
+
+    int tiempoActual = 0;
+    QVector<Proceso*> readyQueue;
+    QMap<QString, int> tiempoRestante;
+    QMap<QString, int> prioridadActual; // Prioridad dinámica con aging
+    QMap<QString, int> ultimoAging;    // Cuando se aplicó último aging
+
+    // Inicialización
+    for (const auto& p : procesos) {
+        tiempoRestante[p.PID] = p.BT;
+        prioridadActual[p.PID] = p.priority;
+        ultimoAging[p.PID] = p.AT;
+    }
+
+    while (true) {
+        // llegado a la ready queue
+        for (auto& p : procesos) {
+            if (p.AT == tiempoActual) {
+                readyQueue.push_back(&p);
+            }
+        }
+
+        // envejecimiento: cada 5 ciclos aumentamos prioridad (disminuimos valor)
+        for (auto& p : readyQueue) {
+            if (tiempoActual - ultimoAging[p->PID] >= intervaloAging) {
+                prioridadActual[p->PID] = std::max(1, prioridadActual[p->PID] - 1);
+                ultimoAging[p->PID] = tiempoActual;
+            }
+        }
+
+        //seleccionar proceso con mayor prioridad, osea el de menor valor. priority 1 es el mas alto
+
+        Proceso* elegido = nullptr;
+        if (!readyQueue.isEmpty()) {
+            std::sort(readyQueue.begin(), readyQueue.end(), [&](Proceso* a, Proceso* b) {
+                return prioridadActual[a->PID] < prioridadActual[b->PID]; // Menor valor = mayor prioridad
+            });
+            elegido = readyQueue.first();
+        }
+
+        // Ejecutar el proceso elegido o IDLE
+        if (elegido && tiempoRestante[elegido->PID] > 0) {
+            // Continuar o crear nuevo segmento
+            if (!resultado.isEmpty() && resultado.last().PID == elegido->PID) {
+                resultado.last().duracion++;
+            } else {
+                resultado.append({elegido->PID, tiempoActual, 1});
+            }
+
+            tiempoRestante[elegido->PID]--;
+
+            // Eliminar si terminó
+            if (tiempoRestante[elegido->PID] == 0) {
+                readyQueue.removeAll(elegido);
+            }
+        }
+
+        // verificar condición de término
+        bool todosTerminados = true;
+        for (const auto& p : procesos) {
+            if (tiempoRestante[p.PID] > 0) {
+                todosTerminados = false;
+                break;
+            }
+        }
+        if (todosTerminados) break;
+
+        tiempoActual++;
+    }
+
+    return resultado;
+}
+
+SyncEngine::SyncEngine(const SyncConfig &config)
+{
+    useSemaphore = config.mode == SyncMode::Semaphore;
+    currentCycle = 0;
+    simulationRunning = false;
+    // En la base los permisos venían del archivo de recursos (parseResourceFile)
+    if (useSemaphore) {
+        for (auto it = config.capacity.cbegin(); it != config.capacity.cend(); ++it) {
+            semaphoreCounts[it.key()] = it.value();
+        }
+    }
+}
+
+// parseActionFile, resetSimulation y prepareSimulation, en el orden en que corrían al
+// cargar las acciones y pulsar "Ejecutar"
+void SyncEngine::load(const QVector<Action> &source)
+{
+    actions.clear();
+    for (const Action &parsed : source) {
+        Action a = parsed;
+        a.completed = false;
+        a.completionCycle = -1;
+        a.waitingSince = -1;
+        actions.append(a);
+
+        if (!resourceInUse.contains(a.resource)) {
+            resourceInUse[a.resource] = false;
+        }
+        if (!semaphoreCounts.contains(a.resource) && useSemaphore) {
+            semaphoreCounts[a.resource] = 1;
+        }
+    }
+
+    // resetSimulation
+    currentCycle = 0;
+    simulationRunning = false;
+
+    for (auto it = waitingQueues.begin(); it != waitingQueues.end(); ++it) {
+        while (!it.value().empty()) {
+            it.value().pop();
+        }
+    }
+
+    for (auto it = resourceInUse.begin(); it != resourceInUse.end(); ++it) {
+        it.value() = false;
+    }
+
+    if (useSemaphore) {
+        for (auto it = semaphoreCounts.begin(); it != semaphoreCounts.end(); ++it) {
+            it.value() = 1;
+        }
+    }
+
+    prepareSimulation();
+    simulationRunning = true;
+}
+
+void SyncEngine::prepareSimulation()
+{
+    for (auto it = resourceInUse.begin(); it != resourceInUse.end(); ++it) {
+        it.value() = false;
+        waitingQueues[it.key()] = std::queue<Action*>();
+    }
+
+    if (useSemaphore) {
+        for (auto it = semaphoreCounts.begin(); it != semaphoreCounts.end(); ++it) {
+            resourceInUse[it.key()] = false;
+        }
+    }
+
+    std::sort(actions.begin(), actions.end(), [](const Action &a, const Action &b) {
+        if (a.cycle == b.cycle) return a.PID < b.PID;
+        return a.cycle < b.cycle;
+    });
+
+    currentCycle = 0;
+}
+
+bool SyncEngine::tryAccessResource(Action* action)
+{
+    if (useSemaphore) {
+        if (semaphoreCounts.contains(action->resource)) {
+            if (semaphoreCounts[action->resource] > 0) {
+                semaphoreCounts[action->resource]--;
+                return true;
+            }
+        }
+    } else {
+        if (!resourceInUse[action->resource]) {
+            resourceInUse[action->resource] = true;
+            return true;
+        }
+    }
+    return false;
+}
+
+void SyncEngine::releaseResource(const QString &resource)
+{
+    if (useSemaphore) {
+        if (semaphoreCounts.contains(resource)) {
+            semaphoreCounts[resource]++;
+        }
+    } else {
+        resourceInUse[resource] = false;
+    }
+}
+
+bool SyncEngine::waitingQueuesEmpty() const
+{
+    for (const auto &queue : waitingQueues) {
+        if (!queue.empty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void SyncEngine::processWaitingActions()
+{
+    for (auto it = waitingQueues.begin(); it != waitingQueues.end(); ++it) {
+        std::queue<Action*>& queue = it.value();
+        if (queue.empty()) continue;
+
+        Action* action = queue.front();
+        if (tryAccessResource(action)) {
+            action->completed = true;
+            action->completionCycle = currentCycle;
+            queue.pop();
+
+            logEvent(action, SyncEventKind::AccessedFromQueue);
+        }
+    }
+}
+
+void SyncEngine::logEvent(Action* action, SyncEventKind kind)
+{
+    cycleEvents.append({currentCycle, int(action - actions.data()), kind});
+}
+
+QVector<int> SyncEngine::waitingActions(const QString &resource) const
+{
+    QVector<int> waiting;
+    std::queue<Action*> queue = waitingQueues.value(resource);
+    for (; !queue.empty(); queue.pop()) {
+        waiting.append(int(queue.front() - actions.data()));
+    }
+    return waiting;
+}
+
+bool SyncEngine::step()
+{
+    cycleEvents.clear();
+    if (!simulationRunning) return true;
+
+    // Liberar recursos de acciones completadas en el ciclo anterior
+    for (Action &action : actions) {
+        if (action.completed && action.completionCycle == currentCycle - 1) {
+            releaseResource(action.resource);
+        }
+    }
+
+    processWaitingActions();
+
+    // Procesar acciones del ciclo actual
+    QVector<Action*> currentActions;
+    for (Action &action : actions) {
+        if (action.cycle == currentCycle && !action.completed) {
+            currentActions.append(&action);
+        }
+    }
+
+    for (Action* action : currentActions) {
+        if (tryAccessResource(action)) {
+            action->completed = true;
+            action->completionCycle = currentCycle;
+            logEvent(action, SyncEventKind::Accessed);
+        } else {
+            waitingQueues[action->resource].push(action);
+            action->waitingSince = currentCycle;
+            logEvent(action, SyncEventKind::Waiting);
+        }
+    }
+
+    // Verificar si la simulación ha terminado
+    bool allCompleted = true;
+    bool allProcessed = true;
+
+    for (const Action &action : actions) {
+        if (!action.completed) {
+            allCompleted = false;
+            if (action.cycle > currentCycle) {
+                allProcessed = false;
+            }
+        }
+    }
+
+    if (allCompleted || (allProcessed && waitingQueuesEmpty())) {
+        simulationRunning = false;
+        return true;
+    }
+
+    currentCycle++;
+    return false;
+}
+
+}
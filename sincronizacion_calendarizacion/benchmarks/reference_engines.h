@@ -0,0 +1,87 @@
+#ifndef REFERENCE_ENGINES_H
+#define REFERENCE_ENGINES_H
+
+#include <QMap>
+#include <QString>
+#include <QVector>
+#include <queue>
+#include "schedulingtypes.h"
+#include "syncengine.h"
+
+// Motores de referencia para la verificación diferencial: el código que tenían las ventanas
+// en la versión base (82165eb), copiado tal cual. Solo cambia lo que ataba el código a la
+// ventana: son funciones libres, y los mensajes del registro de runSimulationStep se
+// guardan como eventos. No se corrigen sus errores ni se cambian sus empates; las
+// diferencias que el optimizado tiene a propósito son las excepciones de abajo, y
+// differential_check las clasifica aparte en vez de contarlas como fallas.
+//
+// Excepciones documentadas (CPU):
+//  - Empates. La referencia ordena con std::sort, que no es estable, así que el orden
+//    entre procesos con la misma clave no está definido (llegada en FIFO, RR y Priority;
+//    ráfaga en SJF; restante en SRT; prioridad en Priority). SRT además recorre los
+//    procesos en orden de PID. El optimizado resuelve el empate a favor del proceso en
+//    CPU y luego del que entró antes a la cola de listos. Una corrida que se separa en un
+//    empate se cuenta como empate y no se sigue comparando.
+//  - Ráfaga 0. En SRT la referencia no saca nunca al proceso de su mapa y no termina; en
+//    Priority lo deja en la cola y, si tiene la mejor prioridad, la CPU queda ociosa. El
+//    optimizado lo da por terminado al llegar. Esos algoritmos se comparan sin ráfagas 0.
+//  - PID repetidos. La referencia indexa por PID; las cargas generadas no los repiten.
+//  - E/S y bloqueo por recursos no existen en la referencia; solo se comparan cargas de CPU.
+//
+// Excepciones documentadas (sincronización):
+//  - Solo mutex y semáforo, retención de un ciclo y un despertar por recurso y ciclo
+//    (WakeOne). Lector-escritor, WakeAll y retenciones largas no existen en la referencia.
+//  - Fin de la corrida. La referencia termina en el ciclo de la última concesión; el
+//    optimizado sigue hasta que se libera la última retención, así que puede correr un
+//    ciclo más sin eventos.
+//  - Permisos. resetSimulation pone todos los semáforos en 1 antes de correr, así que en
+//    la referencia los permisos del archivo de recursos no tienen efecto (y un recurso con
+//    0 permisos tiene 1). El optimizado los respeta; se compara con 1 permiso por recurso.
+//  - Acciones del mismo PID en el mismo ciclo. La referencia las ordena con std::sort y su
+//    orden no está definido; el optimizado conserva el del archivo. No se generan.
+namespace reference {
+
+// Las ventanas de calendarización de la versión base, sin cambios
+QVector<ResultadoSimulacion> ejecutarFIFO(const QVector<Proceso>& procesosOriginales);
+QVector<ResultadoSimulacion> ejecutarSJF(const QVector<Proceso>& procesosOriginales);
+QVector<ResultadoSimulacion> ejecutarSRT(const QVector<Proceso>& procesosOriginales);
+QVector<ResultadoSimulacion> ejecutarRR(const QVector<Proceso>& procesosOriginales, int quantum);
+QVector<ResultadoSimulacion> ejecutarPriorityAging(const QVector<Proceso>& procesosOriginales, int intervaloAging);
+
+// prepareSimulation, tryAccessResource, releaseResource, processWaitingActions y
+// runSimulationStep de la ventana de sincronización base. `config` solo aporta el modo
+// (mutex o semáforo) y los permisos, que en la base venían del archivo de recursos.
+class SyncEngine
+{
+public:
+    explicit SyncEngine(const SyncConfig &config);
+
+    void load(const QVector<Action> &source);
+    bool step();    // runSimulationStep; true cuando la ventana detenía el temporizador
+
+    int cycle() const { return currentCycle; }
+    const QVector<Action> &results() const { return actions; }
+    const QVector<SyncEvent> &lastEvents() const { return cycleEvents; }
+    QVector<int> waitingActions(const QString &resource) const;
+
+private:
+    QVector<Action> actions;
+    QMap<QString, bool> resourceInUse;
+    QMap<QString, int> semaphoreCounts;
+    QMap<QString, std::queue<Action*>> waitingQueues;
+    int currentCycle;
+    bool useSemaphore;
+    bool simulationRunning;
+    QVector<SyncEvent> cycleEvents;     // Lo que la ventana escribía en el registro
+
+    void prepareSimulation();
+    bool tryAccessResource(Action* action);
+    void releaseResource(const QString &resource);
+    bool waitingQueuesEmpty() const;
+    void processWaitingActions();
+    void logEvent(Action* action, SyncEventKind kind);
+};
+
+}
+
+#endif // REFERENCE_ENGINES_H
@@ -0,0 +1,227 @@
+// Benchmark de renderizado del Gantt y de la línea de tiempo de sincronización.
+//
+// Uso: render_benchmark [opciones de Qt Test] [función[:dato] ...]
+//      por ejemplo: render_benchmark ganttPaint:"4000 ciclos" -iterations 20
+//
+// Dibuja resultados sintéticos de tamaño creciente en las ventanas reales, sin pantalla
+// (QT_QPA_PLATFORM=offscreen salvo que se indique otra plataforma). Por vista hay tres mediciones:
+//  - *Scene: construir la escena completa, con la cantidad de elementos como dato adicional;
+//  - *Memory: bytes de heap que retiene la escena terminada (solo con glibc);
+//  - *Paint: pintar un cuadro de la vista de 1280x800 en una imagen.
+// Los resultados sintéticos salen de una semilla fija, así que dos corridas son comparables
+// entre cambios del renderizador.
+
+#include "schedulingwindow.h"
+#include "synchronizationwindow.h"
+
+#include <QApplication>
+#include <QGraphicsView>
+#include <QImage>
+#include <QtTest>
+#include <random>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace {
+
+const int GANTT_ROWS = 7;       // Una fila por algoritmo, como al simular todos
+const QSize FRAME_SIZE(1280, 800);
+
+// Tramos de 1 a 4 ciclos entre `cycles / 20` procesos, con huecos ociosos ocasionales; el
+// último tramo siempre corre para que la fila llegue a `cycles`
+Timeline syntheticTimeline(int cycles)
+{
+    std::mt19937 rng(1);
+    int processes = std::max(4, cycles / 20);
+    Timeline timeline;
+    int cycle = 0;
+    while (cycle < cycles) {
+        int length = std::min(int(rng() % 4) + 1, cycles - cycle);
+        if (rng() % 8 != 0 || cycle + length == cycles) {
+            timeline.append(QString("P%1").arg(int(rng() % processes)), cycle, length);
+        }
+        cycle += length;
+    }
+    return timeline;
+}
+
+// Corrida de semáforo de dos permisos: ocho procesos sobre cuatro recursos, con colas de espera
+SyncRunResult syntheticRun(int actionCount)
+{
+    std::mt19937 rng(1);
+    QVector<Action> actions;
+    for (int i = 0; i < actionCount; ++i) {
+        Action action;
+        action.PID = QString("P%1").arg(int(rng() % 8) + 1);
+        action.action = rng() % 3 == 0 ? "WRITE" : "READ";
+        action.resource = QString("R%1").arg(int(rng() % 4) + 1);
+        action.cycle = int(rng() % std::max(1, actionCount / 2));
+        action.holdCycles = int(rng() % 4) + 1;
+        action.completed = false;
+        action.completionCycle = -1;
+        action.waitingSince = -1;
+        action.realWaitCycles = -1;
+        actions.append(action);
+    }
+
+    SyncConfig config;
+    config.mode = SyncMode::Semaphore;
+    for (int r = 1; r <= 4; ++r) config.capacity.insert(QString("R%1").arg(r), 2);
+    SyncEngine engine(config, false);
+    engine.load(actions);
+    return engine.runToCompletion();
+}
+
+// Bytes de heap en uso; -1 si la plataforma no lo reporta
+qint64 heapInUse()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+    return qint64(mallinfo2().uordblks);
+#else
+    return -1;
+#endif
+}
+
+QGraphicsView *graphicsView(QWidget &window)
+{
+    return window.findChild<QGraphicsView *>();
+}
+
+void drawGantt(SchedulingWindow &window, const Timeline &timeline)
+{
+    window.limpiarEscena();
+    for (int row = 1; row <= GANTT_ROWS; ++row) {
+        window.dibujarResultado(timeline, QString("Algoritmo %1").arg(row), row);
+    }
+}
+
+// Pinta la vista tal como está (desplazamiento y escala de la ventana) en una imagen
+void paintFrames(QWidget &window)
+{
+    window.resize(FRAME_SIZE);
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+    QWidget *viewport = graphicsView(window)->viewport();
+    QImage frame(viewport->size(), QImage::Format_ARGB32_Premultiplied);
+    QBENCHMARK {
+        viewport->render(&frame);
+    }
+}
+
+}
+
+class RenderBenchmark : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void ganttScene_data() { ganttSizes(); }
+    void ganttScene();
+    void ganttMemory_data() { ganttSizes(); }
+    void ganttMemory();
+    void ganttPaint_data() { ganttSizes(); }
+    void ganttPaint();
+
+    void syncScene_data() { syncSizes(); }
+    void syncScene();
+    void syncMemory_data() { syncSizes(); }
+    void syncMemory();
+    void syncPaint_data() { syncSizes(); }
+    void syncPaint();
+
+private:
+    void ganttSizes();
+    void syncSizes();
+};
+
+void RenderBenchmark::ganttSizes()
+{
+    QTest::addColumn<int>("cycles");
+    for (int cycles : {100, 1000, 4000}) {
+        QTest::newRow(qPrintable(QString("%1 ciclos").arg(cycles))) << cycles;
+    }
+}
+
+void RenderBenchmark::syncSizes()
+{
+    QTest::addColumn<int>("actions");
+    for (int actions : {20, 100, 400}) {
+        QTest::newRow(qPrintable(QString("%1 acciones").arg(actions))) << actions;
+    }
+}
+
+// Incluye limpiar la escena anterior, como al volver a simular
+void RenderBenchmark::ganttScene()
+{
+    QFETCH(int, cycles);
+    Timeline timeline = syntheticTimeline(cycles);
+    SchedulingWindow window;
+    QBENCHMARK {
+        drawGantt(window, timeline);
+    }
+    qInfo("%d ciclos x %d filas: %lld elementos", cycles, GANTT_ROWS,
+          qint64(graphicsView(window)->scene()->items().size()));
+}
+
+void RenderBenchmark::ganttMemory()
+{
+    QFETCH(int, cycles);
+    if (heapInUse() < 0) QSKIP("La memoria de la escena solo se mide con glibc");
+    Timeline timeline = syntheticTimeline(cycles);
+    SchedulingWindow window;
+    qint64 before = heapInUse();
+    drawGantt(window, timeline);
+    QTest::setBenchmarkResult(heapInUse() - before, QTest::BytesAllocated);
+}
+
+void RenderBenchmark::ganttPaint()
+{
+    QFETCH(int, cycles);
+    SchedulingWindow window;
+    drawGantt(window, syntheticTimeline(cycles));
+    paintFrames(window);
+}
+
+// Incluye armar la línea de tiempo y las fotos de la reproducción, que la ventana rehace por corrida
+void RenderBenchmark::syncScene()
+{
+    QFETCH(int, actions);
+    SyncRunResult run = syntheticRun(actions);
+    SynchronizationWindow window;
+    QBENCHMARK {
+        window.drawRun(run);
+    }
+    qInfo("%d acciones, %d ciclos: %lld elementos", actions, run.finalCycle + 1,
+          qint64(graphicsView(window)->scene()->items().size()));
+}
+
+void RenderBenchmark::syncMemory()
+{
+    QFETCH(int, actions);
+    if (heapInUse() < 0) QSKIP("La memoria de la escena solo se mide con glibc");
+    SyncRunResult run = syntheticRun(actions);
+    SynchronizationWindow window;
+    qint64 before = heapInUse();
+    window.drawRun(run);
+    QTest::setBenchmarkResult(heapInUse() - before, QTest::BytesAllocated);
+}
+
+void RenderBenchmark::syncPaint()
+{
+    QFETCH(int, actions);
+    SynchronizationWindow window;
+    window.drawRun(syntheticRun(actions));
+    paintFrames(window);
+}
+
+int main(int argc, char *argv[])
+{
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) qputenv("QT_QPA_PLATFORM", "offscreen");
+    QApplication app(argc, argv);
+    RenderBenchmark benchmark;
+    return QTest::qExec(&benchmark, argc, argv);
+}
+
+#include "render_benchmark.moc"
@@ -0,0 +1,113 @@
+#include "cpusyncengine.h"
+#include "schedulercore.h"
+
+namespace {
+
+// Lee la columna BT: un entero o una secuencia de ráfagas
+bool parseBursts(const QString &text, Proceso &proceso, QString &error)
+{
+    const QStringList tokens = text.split(' ', Qt::SkipEmptyParts);
+    if (tokens.size() == 1 && !tokens[0].contains(':')) {
+        bool ok = false;
+        proceso.BT = tokens[0].toInt(&ok);
+        if (!ok || proceso.BT < 0) {
+            error = "BT inválido";
+            return false;
+        }
+        return true;
+    }
+
+    proceso.BT = 0;
+    for (const QString &token : tokens) {
+        Rafaga rafaga;
+        bool ok = false;
+        int separator = token.indexOf(':');
+        if (separator == -1) {
+            rafaga.duracion = token.toInt(&ok);
+        } else {
+            rafaga.dispositivo = token.left(separator).trimmed().toUpper();
+            rafaga.duracion = token.mid(separator + 1).toInt(&ok);
+            ok = ok && !rafaga.dispositivo.isEmpty();
+        }
+        if (!ok || rafaga.duracion <= 0) {
+            error = "ráfaga inválida '" + token + "'";
+            return false;
+        }
+
+        // Ráfagas de CPU consecutivas se funden en una
+        if (rafaga.dispositivo.isEmpty() && !proceso.rafagas.isEmpty() && proceso.rafagas.last().dispositivo.isEmpty()) {
+            proceso.rafagas.last().duracion += rafaga.duracion;
+        } else {
+            proceso.rafagas.append(rafaga);
+        }
+        if (rafaga.dispositivo.isEmpty()) proceso.BT += rafaga.duracion;
+    }
+
+    if (proceso.rafagas.isEmpty() || !proceso.rafagas.first().dispositivo.isEmpty() ||
+        !proceso.rafagas.last().dispositivo.isEmpty()) {
+        error = "las ráfagas deben empezar y terminar en CPU";
+        return false;
+    }
+    return true;
+}
+
+}
+
+// Cada caso instancia el núcleo con su política; la elección se hace una sola vez
+CpuSyncResult simulateCpuWithBlocking(const QVector<Proceso> &procesos, const QVector<Action> &actions,
+                                      const CpuSyncConfig &config)
+{
+    switch (config.algorithm) {
+    case SchedulingAlgorithm::SJF:
+        return runScheduler(procesos, ShortestBurstPolicy(), actions, config.capacity);
+    case SchedulingAlgorithm::SRT:
+        return runScheduler(procesos, ShortestRemainingPolicy(), actions, config.capacity);
+    case SchedulingAlgorithm::RoundRobin:
+        return runScheduler(procesos, RoundRobinPolicy{config.quantum}, actions, config.capacity);
+    case SchedulingAlgorithm::PriorityAging:
+        return runScheduler(procesos, AgingPriorityPolicy{config.agingInterval}, actions, config.capacity);
+    case SchedulingAlgorithm::FIFO:
+        break;
+    }
+    return runScheduler(procesos, FifoPolicy(), actions, config.capacity);
+}
+
+bool parseProcessLine(const QString &line, Proceso &proceso, QString *error)
+{
+    const QStringList partes = line.split(',', Qt::SkipEmptyParts);
+    if (partes.size() < 4 || partes.size() > 6) {
+        if (error) *error = "se esperaban entre 4 y 6 campos";
+        return false;
+    }
+
+    QString detalle;
+    proceso = Proceso();
+    proceso.PID = partes[0].trimmed();
+    proceso.AT = partes[2].trimmed().toInt();
+    proceso.priority = partes[3].trimmed().toInt();
+    if (partes.size() > 4) proceso.deadline = std::max(0, partes[4].trimmed().toInt());
+    if (partes.size() > 5) proceso.periodo = std::max(0, partes[5].trimmed().toInt());
+    if (!parseBursts(partes[1].trimmed(), proceso, detalle)) {
+        if (error) *error = "(" + proceso.PID + ") " + detalle;
+        return false;
+    }
+    return true;
+}
+
+QVector<Proceso> parseProcesses(const QString &content, QStringList *errors, int firstLine)
+{
+    QVector<Proceso> procesos;
+    const QStringList lineas = content.split('\n');
+    for (int i = 0; i < lineas.size(); ++i) {
+        if (lineas[i].trimmed().isEmpty()) continue;
+
+        Proceso p;
+        QString error;
+        if (!parseProcessLine(lineas[i], p, &error)) {
+            if (errors) *errors << QString("Línea %1: %2").arg(firstLine + i).arg(error);
+            continue;
+        }
+        procesos.append(p);
+    }
+    return procesos;
+}
@@ -0,0 +1,65 @@
+#ifndef CPUSYNCENGINE_H
+#define CPUSYNCENGINE_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QMap>
+#include "schedulingtypes.h"
+#include "syncengine.h"
+#include "timeline.h"
+
+enum class SchedulingAlgorithm {
+    FIFO,
+    SJF,
+    SRT,
+    RoundRobin,
+    PriorityAging
+};
+
+struct CpuSyncConfig {
+    SchedulingAlgorithm algorithm = SchedulingAlgorithm::FIFO;
+    int quantum = 2;
+    int agingInterval = 5;
+    QMap<QString, int> capacity;    // Permisos por recurso; 1 (mutex) si no aparece
+};
+
+struct CpuSyncResult {
+    Timeline timeline;                              // Uso de CPU; los dueños son los PID
+    QVector<ResultadoSimulacion> blockedSegments;   // Tramos fuera de CPU esperando un recurso
+    QMap<QString, QVector<ResultadoSimulacion>> deviceSegments;    // Uso de cada dispositivo de E/S
+    int totalCycles = 0;
+    int busyCycles = 0;
+    int idleCycles = 0;
+    int idleWhileBlocked = 0;   // Ciclos de CPU ociosa mientras algún proceso esperaba un recurso
+    int finishedProcesses = 0;
+    QMap<QString, int> blockedCycles;
+    QMap<QString, int> deviceBusy;      // Ciclos ocupados por dispositivo
+    QMap<QString, int> deviceWait;      // Ciclos de espera en la cola de cada dispositivo
+    int cpuIoOverlap = 0;   // Ciclos con la CPU y al menos un dispositivo ocupados a la vez
+    QStringList unfinished;     // Procesos que no terminaron (recurso sin permisos)
+    int decisions = 0;          // Elecciones de la cola de listos; 0 sin instrumentación
+};
+
+// Calendariza los procesos con cualquiera de los algoritmos y les deja pedir recursos.
+// Cada proceso alterna ráfagas de CPU y de E/S; una ráfaga de E/S espera en la cola FIFO
+// de su dispositivo, que atiende a un proceso a la vez. La simulación salta de evento en
+// evento (llegadas, fin de ráfagas, fin de uso de recursos) en lugar de avanzar por ciclo.
+// En el modo combinado el CICLO de una acción es el tiempo de CPU ya ejecutado por el
+// proceso cuando la pide, y HOLD son los ciclos que usa el recurso fuera de la CPU antes de
+// soltarlo y volver a la cola de listos. Un proceso sin permiso también sale de la CPU y
+// espera en la cola del recurso hasta que se le concede.
+CpuSyncResult simulateCpuWithBlocking(const QVector<Proceso> &procesos, const QVector<Action> &actions,
+                                      const CpuSyncConfig &config);
+
+// Lee un archivo de procesos. Formato: PID, BT, AT, Priority[, DEADLINE[, PERIODO]], donde
+// BT es un entero o una secuencia de ráfagas separadas por espacios: enteros para CPU y
+// DISPOSITIVO:N para E/S, empezando y terminando en CPU (por ejemplo "3 DISCO:4 2"). Un
+// plazo o periodo 0 equivale a no tenerlo. Las líneas inválidas se omiten y se describen
+// en `errors`, numeradas desde `firstLine` (para parsear un archivo por bloques).
+QVector<Proceso> parseProcesses(const QString &content, QStringList *errors = nullptr, int firstLine = 1);
+
+// Lee una sola línea del archivo de procesos; false y la causa en `error` si no es válida
+bool parseProcessLine(const QString &line, Proceso &proceso, QString *error = nullptr);
+
+#endif // CPUSYNCENGINE_H
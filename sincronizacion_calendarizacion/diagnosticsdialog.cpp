@@ -0,0 +1,66 @@
+#include "diagnosticsdialog.h"
+#include <QFile>
+#include <QFileDialog>
+#include <QFontDatabase>
+#include <QHBoxLayout>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QVBoxLayout>
+
+DiagnosticsDialog::DiagnosticsDialog(SimProfile &profile, const QString &source, QWidget *parent) :
+    QDialog(parent),
+    profile(profile),
+    source(source)
+{
+    setWindowTitle("Diagnóstico: " + source);
+    resize(560, 360);
+
+    view = new QPlainTextEdit(this);
+    view->setReadOnly(true);
+    view->setFont(QFontDatabase::systemFont(QFontDatabase::FixedFont));
+
+    QPushButton *btnReset = new QPushButton("Reiniciar", this);
+    QPushButton *btnExport = new QPushButton("Exportar JSON", this);
+    QPushButton *btnClose = new QPushButton("Cerrar", this);
+    connect(btnReset, &QPushButton::clicked, this, [this]() {
+        this->profile.reset();
+        refresh();
+    });
+    connect(btnExport, &QPushButton::clicked, this, &DiagnosticsDialog::exportJson);
+    connect(btnClose, &QPushButton::clicked, this, &QDialog::close);
+
+    QHBoxLayout *buttons = new QHBoxLayout();
+    buttons->addWidget(btnReset);
+    buttons->addStretch();
+    buttons->addWidget(btnExport);
+    buttons->addWidget(btnClose);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->addWidget(view);
+    layout->addLayout(buttons);
+
+    // Se refresca solo mientras está visible
+    connect(&timer, &QTimer::timeout, this, &DiagnosticsDialog::refresh);
+    timer.start(500);
+}
+
+void DiagnosticsDialog::refresh()
+{
+    if (!isVisible()) return;
+    QString text = profile.toText();
+    if (text != view->toPlainText()) view->setPlainText(text);
+}
+
+void DiagnosticsDialog::exportJson()
+{
+    QString filePath = QFileDialog::getSaveFileName(this, "Exportar diagnóstico",
+                                                    "diagnostico_" + source + ".json", "Archivos JSON (*.json)");
+    if (filePath.isEmpty()) return;
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        QMessageBox::warning(this, "Advertencia", "No se pudo escribir " + filePath);
+        return;
+    }
+    file.write(profile.toJson(source));
+}
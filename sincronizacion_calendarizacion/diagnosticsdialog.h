@@ -0,0 +1,27 @@
+#ifndef DIAGNOSTICSDIALOG_H
+#define DIAGNOSTICSDIALOG_H
+
+#include <QDialog>
+#include <QPlainTextEdit>
+#include <QTimer>
+#include "siminstrumentation.h"
+
+// Panel de diagnóstico: muestra el perfil de una ventana y lo refresca mientras la
+// simulación o la animación siguen corriendo. Permite reiniciarlo y exportarlo a JSON.
+class DiagnosticsDialog : public QDialog
+{
+public:
+    DiagnosticsDialog(SimProfile &profile, const QString &source, QWidget *parent = nullptr);
+
+    void refresh();
+
+private:
+    SimProfile &profile;
+    QString source;
+    QPlainTextEdit *view;
+    QTimer timer;
+
+    void exportJson();
+};
+
+#endif // DIAGNOSTICSDIALOG_H
@@ -0,0 +1,133 @@
+#include "fileloader.h"
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QProgressBar>
+#include <QPushButton>
+
+FileLoader::FileLoader(QObject *parent) :
+    QObject(parent)
+{
+}
+
+FileLoader::~FileLoader()
+{
+    cancel();
+    if (worker.joinable()) worker.join();
+}
+
+bool FileLoader::start(const QString &path, Consumer consume, Done done)
+{
+    if (isRunning()) return false;
+    if (worker.joinable()) worker.join();   // El hilo anterior ya terminó; solo falta unirlo
+
+    cancelled.store(false, std::memory_order_relaxed);
+    running.store(true, std::memory_order_release);
+    emit started(path);
+    worker = std::thread([this, path, consume, done]() { run(path, consume, done); });
+    return true;
+}
+
+void FileLoader::run(const QString &path, const Consumer &consume, const Done &done)
+{
+    QElapsedTimer elapsed;
+    elapsed.start();
+    LoadStats stats;
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        finish(false, "No se pudo abrir " + path + ": " + file.errorString(), done, stats);
+        return;
+    }
+    const qint64 totalBytes = file.size();
+
+    QByteArray pending;     // Resto de la última línea incompleta
+    int nextLine = 1;
+    QElapsedTimer sinceReport;
+    sinceReport.start();
+
+    while (!cancelled.load(std::memory_order_relaxed)) {
+        QByteArray block = file.read(CHUNK_BYTES);
+        if (file.error() != QFileDevice::NoError) {
+            finish(false, "Error al leer " + path + ": " + file.errorString(), done, stats);
+            return;
+        }
+        const bool atEnd = block.isEmpty();
+        stats.bytes += block.size();
+        pending += block;
+
+        // Solo se parsean líneas completas; el final del archivo cierra la última
+        int cut = atEnd ? pending.size() : pending.lastIndexOf('\n') + 1;
+        if (cut > 0) {
+            QString chunk = QString::fromUtf8(pending.constData(), cut);
+            chunk.remove(QLatin1Char('\r'));
+            stats.records += consume(chunk, nextLine);
+            nextLine += chunk.count(QLatin1Char('\n'));
+            pending.remove(0, cut);
+        }
+        if (atEnd) break;
+
+        if (sinceReport.elapsed() >= PROGRESS_INTERVAL_MS) {
+            emit progress(stats.bytes, totalBytes, stats.records);
+            sinceReport.restart();
+        }
+    }
+
+    if (cancelled.load(std::memory_order_relaxed)) {
+        finish(false, QString(), done, stats);
+        return;
+    }
+    stats.nanoseconds = elapsed.nsecsElapsed();
+    emit progress(stats.bytes, totalBytes, stats.records);
+    finish(true, QString(), done, stats);
+}
+
+void FileLoader::finish(bool completed, const QString &error, const Done &done, const LoadStats &stats)
+{
+    running.store(false, std::memory_order_release);
+    // El resultado se entrega en el hilo del cargador, después de todo lo que escribió `consume`
+    QMetaObject::invokeMethod(this, [this, completed, error, done, stats]() {
+        if (completed && done) done(stats);
+        emit finished(completed, error);
+    }, Qt::QueuedConnection);
+}
+
+LoadProgressPanel::LoadProgressPanel(FileLoader *loader, QWidget *parent) :
+    QWidget(parent)
+{
+    label = new QLabel(this);
+    bar = new QProgressBar(this);
+    bar->setMaximumWidth(200);
+    cancelButton = new QPushButton("Cancelar", this);
+
+    QHBoxLayout *layout = new QHBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->addWidget(label);
+    layout->addWidget(bar);
+    layout->addWidget(cancelButton);
+    hide();
+
+    connect(cancelButton, &QPushButton::clicked, loader, &FileLoader::cancel);
+    connect(loader, &FileLoader::started, this, [this](const QString &path) {
+        label->setText("Cargando " + QFileInfo(path).fileName());
+        bar->setRange(0, 0);
+        show();
+    });
+    connect(loader, &FileLoader::progress, this, &LoadProgressPanel::showProgress);
+    connect(loader, &FileLoader::finished, this, &QWidget::hide);
+}
+
+void LoadProgressPanel::showProgress(qint64 bytesRead, qint64 totalBytes, int records)
+{
+    // La barra va en KiB para no desbordar el rango entero con archivos grandes
+    if (totalBytes > 0) {
+        bar->setRange(0, int(totalBytes / 1024) + 1);
+        bar->setValue(int(bytesRead / 1024));
+    }
+    label->setText(QString("%1 de %2 MB, %3 registros")
+                       .arg(bytesRead / 1048576.0, 0, 'f', 1)
+                       .arg(totalBytes / 1048576.0, 0, 'f', 1)
+                       .arg(records));
+}
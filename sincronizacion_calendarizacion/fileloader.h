@@ -0,0 +1,77 @@
+#ifndef FILELOADER_H
+#define FILELOADER_H
+
+#include <QObject>
+#include <QString>
+#include <QWidget>
+#include <atomic>
+#include <functional>
+#include <thread>
+
+class QLabel;
+class QProgressBar;
+class QPushButton;
+
+// Totales de una carga terminada
+struct LoadStats {
+    qint64 bytes = 0;
+    int records = 0;
+    qint64 nanoseconds = 0;     // Lectura y parseo, medidos en el hilo de carga
+};
+
+// Lee un archivo de texto en un hilo aparte, en bloques de líneas completas. Cada bloque
+// pasa a `consume` en ese mismo hilo, que lo parsea y devuelve cuántos registros sacó; así
+// la ventana recibe el resultado ya listo para simular. El progreso llega por señales a lo
+// sumo cada PROGRESS_INTERVAL_MS, y cancel() corta la lectura al terminar el bloque en curso.
+// Hay una carga a la vez por cargador.
+class FileLoader : public QObject
+{
+    Q_OBJECT
+
+public:
+    // consume(bloque, número de la primera línea del bloque) -> registros parseados
+    using Consumer = std::function<int(const QString &chunk, int firstLine)>;
+    using Done = std::function<void(const LoadStats &stats)>;
+
+    explicit FileLoader(QObject *parent = nullptr);
+    ~FileLoader() override;     // Cancela y espera al hilo de carga
+
+    // false si ya hay una carga en curso. `done` corre en el hilo del cargador y solo si la
+    // carga terminó sin cancelarse ni fallar.
+    bool start(const QString &path, Consumer consume, Done done);
+    void cancel() { cancelled.store(true, std::memory_order_relaxed); }
+    bool isRunning() const { return running.load(std::memory_order_acquire); }
+
+signals:
+    void started(const QString &path);
+    void progress(qint64 bytesRead, qint64 totalBytes, int records);
+    void finished(bool completed, const QString &error);    // error vacío si se canceló
+
+private:
+    static const int CHUNK_BYTES = 1 << 20;
+    static const int PROGRESS_INTERVAL_MS = 100;
+
+    std::thread worker;
+    std::atomic<bool> running{false};
+    std::atomic<bool> cancelled{false};
+
+    void run(const QString &path, const Consumer &consume, const Done &done);
+    void finish(bool completed, const QString &error, const Done &done, const LoadStats &stats);
+};
+
+// Barra de progreso y botón de cancelar para la barra de estado de una ventana; solo se
+// ve mientras el cargador tiene una carga en curso
+class LoadProgressPanel : public QWidget
+{
+public:
+    explicit LoadProgressPanel(FileLoader *loader, QWidget *parent = nullptr);
+
+private:
+    QLabel *label;
+    QProgressBar *bar;
+    QPushButton *cancelButton;
+
+    void showProgress(qint64 bytesRead, qint64 totalBytes, int records);
+};
+
+#endif // FILELOADER_H
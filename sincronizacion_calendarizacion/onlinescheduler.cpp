@@ -0,0 +1,174 @@
+#include "onlinescheduler.h"
+#include <algorithm>
+#include <climits>
+#include <utility>
+
+OnlineScheduler::OnlineScheduler(const OnlineConfig &config, SegmentSink sink)
+    : config(config), sink(std::move(sink))
+{
+    window.resize(std::max(1, config.metricsWindow));
+    switch (config.algorithm) {
+    case SchedulingAlgorithm::SJF:
+        ready.emplace<ReadyQueue<ShortestBurstPolicy>>();
+        break;
+    case SchedulingAlgorithm::SRT:
+        ready.emplace<ReadyQueue<ShortestRemainingPolicy>>();
+        break;
+    case SchedulingAlgorithm::RoundRobin:
+        ready.emplace<ReadyQueue<RoundRobinPolicy>>(RoundRobinPolicy{config.quantum});
+        break;
+    case SchedulingAlgorithm::PriorityAging:
+        ready.emplace<ReadyQueue<AgingPriorityPolicy>>(AgingPriorityPolicy{config.agingInterval});
+        break;
+    case SchedulingAlgorithm::FIFO:
+        break;
+    }
+}
+
+bool OnlineScheduler::idle() const
+{
+    return std::visit([](const auto &queue) { return queue.idle(); }, ready);
+}
+
+void OnlineScheduler::submit(const Proceso &proceso)
+{
+    int arrival = proceso.AT;
+    if (arrival < now) {
+        stats.lateArrivals++;
+        arrival = now;
+    }
+    advanceTo(arrival);
+
+    Task task;
+    task.PID = proceso.PID;
+    task.arrival = arrival;
+    task.burstLength = proceso.BT;
+    task.remaining = proceso.BT;
+    task.priority = proceso.priority;
+    task.lastAging = arrival;
+    task.firstRun = -1;
+
+    int slot;
+    if (freeSlots.empty()) {
+        slot = int(tasks.size());
+        tasks.push_back(task);
+    } else {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+        tasks[slot] = task;
+    }
+
+    stats.submitted++;
+    stats.inSystem++;
+    stats.peakInSystem = std::max(stats.peakInSystem, stats.inSystem);
+    if (task.remaining <= 0) {
+        complete(slot);
+    } else {
+        std::visit([this, slot](auto &queue) { queue.push(tasks, slot); }, ready);
+    }
+}
+
+void OnlineScheduler::advanceTo(int cycle)
+{
+    while (now < cycle) {
+        if (!step(cycle)) {
+            stats.idleCycles += cycle - now;
+            now = cycle;
+        }
+    }
+    stats.cycle = now;
+}
+
+void OnlineScheduler::drainTo(int cycle)
+{
+    while (now < cycle && step(cycle)) {
+    }
+    stats.cycle = now;
+}
+
+void OnlineScheduler::finish()
+{
+    while (step(INT_MAX)) {
+    }
+    closeSegment();
+    stats.cycle = now;
+}
+
+bool OnlineScheduler::step(int limit)
+{
+    return std::visit([this, limit](auto &queue) { return step(queue, limit); }, ready);
+}
+
+// Las llegadas futuras no se conocen: el tramo solo se corta por el límite de advanceTo
+template <typename Queue>
+bool OnlineScheduler::step(Queue &queue, int limit)
+{
+    queue.age(tasks, now);
+    int slot = queue.pick(tasks);
+    if (slot == -1) {
+        closeSegment();
+        return false;
+    }
+
+    Task &task = tasks[slot];
+    int cycles = std::min({task.remaining, queue.sliceLimit(tasks, now), limit - now});
+    if (task.firstRun == -1) task.firstRun = now;
+
+    if (hasOpenSegment && openSegment.PID == task.PID && openSegment.inicio + openSegment.duracion == now) {
+        openSegment.duracion += cycles;
+    } else {
+        closeSegment();
+        openSegment = {task.PID, now, cycles};
+        hasOpenSegment = true;
+    }
+
+    stats.busyCycles += cycles;
+    task.remaining -= cycles;
+    now += cycles;
+
+    if (task.remaining == 0) {
+        queue.release();
+        complete(slot);
+    } else {
+        queue.charge(cycles);
+    }
+    return true;
+}
+
+void OnlineScheduler::complete(int slot)
+{
+    const Task &task = tasks[slot];
+    int firstRun = task.firstRun == -1 ? now : task.firstRun;
+    Completion sample = {now - task.arrival - task.burstLength, firstRun - task.arrival, now - task.arrival};
+
+    // Ventana circular: el más viejo sale de las sumas cuando entra el nuevo
+    const int capacity = int(window.size());
+    if (stats.windowSize == capacity) {
+        const Completion &oldest = window[windowNext];
+        windowSums[0] -= oldest.waiting;
+        windowSums[1] -= oldest.response;
+        windowSums[2] -= oldest.turnaround;
+    } else {
+        stats.windowSize++;
+    }
+    window[windowNext] = sample;
+    windowNext = (windowNext + 1) % capacity;
+    windowSums[0] += sample.waiting;
+    windowSums[1] += sample.response;
+    windowSums[2] += sample.turnaround;
+    stats.windowWaiting = double(windowSums[0]) / stats.windowSize;
+    stats.windowResponse = double(windowSums[1]) / stats.windowSize;
+    stats.windowTurnaround = double(windowSums[2]) / stats.windowSize;
+
+    stats.completed++;
+    stats.inSystem--;
+    tasks[slot].PID = QString();
+    freeSlots.push_back(slot);
+}
+
+void OnlineScheduler::closeSegment()
+{
+    if (!hasOpenSegment) return;
+    sink(openSegment);
+    hasOpenSegment = false;
+}
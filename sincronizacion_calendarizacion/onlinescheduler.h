@@ -0,0 +1,96 @@
+#ifndef ONLINESCHEDULER_H
+#define ONLINESCHEDULER_H
+
+#include <QString>
+#include <functional>
+#include <variant>
+#include <vector>
+#include "schedulingtypes.h"
+#include "cpusyncengine.h"
+#include "schedulerpolicies.h"
+
+struct OnlineConfig {
+    SchedulingAlgorithm algorithm = SchedulingAlgorithm::FIFO;
+    int quantum = 2;
+    int agingInterval = 5;
+    int metricsWindow = 100;    // Procesos terminados que entran en las métricas móviles
+};
+
+struct OnlineMetrics {
+    int cycle = 0;
+    long long busyCycles = 0;
+    long long idleCycles = 0;
+    long long submitted = 0;
+    long long completed = 0;
+    long long lateArrivals = 0; // Llegadas con AT anterior al reloj; se admiten en el ciclo actual
+    int inSystem = 0;
+    int peakInSystem = 0;
+    // Promedios sobre los últimos `metricsWindow` procesos terminados
+    int windowSize = 0;
+    double windowWaiting = 0;       // Fin - llegada - BT
+    double windowResponse = 0;      // Primer ciclo en CPU - llegada
+    double windowTurnaround = 0;    // Fin - llegada
+};
+
+// Calendarizador en línea: recibe los procesos en orden de llegada y entrega los tramos de
+// CPU en cuanto se cierran, sin conocer el resto de la traza. Un proceso que llega en AT
+// permite simular hasta AT, porque ya no puede llegar nada antes. La memoria es proporcional
+// a los procesos presentes en el sistema y a la ventana de métricas, no a la traza completa.
+// Solo calendariza CPU: un proceso con ráfagas de E/S usa su BT total. Con la traza completa
+// produce los mismos tramos que simulateCpuWithBlocking sin recursos: ambos usan las mismas
+// políticas de schedulerpolicies.h.
+class OnlineScheduler
+{
+public:
+    using SegmentSink = std::function<void(const ResultadoSimulacion &)>;
+
+    OnlineScheduler(const OnlineConfig &config, SegmentSink sink);
+
+    void submit(const Proceso &proceso);    // Simula hasta su llegada y lo encola
+    void advanceTo(int cycle);              // Simula hasta `cycle` sabiendo que antes no llega nada
+    void drainTo(int cycle);                // Como advanceTo, pero se detiene si la CPU queda ociosa
+    void finish();                          // Termina todo lo pendiente y cierra el último tramo
+
+    bool idle() const;
+    const OnlineMetrics &metrics() const { return stats; }
+
+private:
+    struct Task {
+        QString PID;
+        int arrival;
+        int burstLength;
+        int remaining;
+        int priority;
+        int lastAging;
+        int firstRun;
+    };
+
+    struct Completion {
+        int waiting;
+        int response;
+        int turnaround;
+    };
+
+    OnlineConfig config;
+    SegmentSink sink;
+    std::vector<Task> tasks;        // Ranuras reutilizables de los procesos presentes
+    std::vector<int> freeSlots;
+    // La política se elige en ejecución, pero cada tramo corre con su comparador ya resuelto
+    std::variant<ReadyQueue<FifoPolicy>, ReadyQueue<ShortestBurstPolicy>, ReadyQueue<ShortestRemainingPolicy>,
+                 ReadyQueue<RoundRobinPolicy>, ReadyQueue<AgingPriorityPolicy>> ready;
+    int now = 0;
+    ResultadoSimulacion openSegment;
+    bool hasOpenSegment = false;
+    std::vector<Completion> window;
+    int windowNext = 0;
+    long long windowSums[3] = {0, 0, 0};
+    OnlineMetrics stats;
+
+    bool step(int limit);   // Corre un tramo antes de `limit`; false si la CPU queda ociosa
+    template <typename Queue>
+    bool step(Queue &queue, int limit);
+    void complete(int task);
+    void closeSegment();
+};
+
+#endif // ONLINESCHEDULER_H
@@ -0,0 +1,38 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Ejecuta body(i) para i en [0, count) repartiendo los índices dinámicamente entre
+// `threads` hilos (0 = núcleos disponibles). Cada hilo toma el siguiente índice libre,
+// así un fragmento grande no deja a los demás hilos ociosos.
+template <typename Body>
+void parallelFor(int count, Body body, int threads = 0)
+{
+    if (count <= 0) return;
+    if (threads <= 0) threads = int(std::max(1u, std::thread::hardware_concurrency()));
+    threads = std::min(threads, count);
+
+    if (threads == 1) {
+        for (int i = 0; i < count; ++i) body(i);
+        return;
+    }
+
+    std::atomic<int> next{0};
+    auto worker = [&]() {
+        for (int i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            body(i);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    pool.reserve(threads - 1);
+    for (int t = 1; t < threads; ++t) pool.emplace_back(worker);
+    worker();
+    for (std::thread &thread : pool) thread.join();
+}
+
+#endif // PARALLEL_H
@@ -0,0 +1,150 @@
+#include "realthreadrunner.h"
+#include <thread>
+#include <mutex>
+#include <shared_mutex>
+#include <semaphore>
+#include <memory>
+#include <algorithm>
+#include <numeric>
+
+namespace {
+
+// Candado de un recurso; solo se construye la primitiva del modo elegido
+struct RealLock {
+    std::mutex mutex;
+    std::shared_mutex sharedMutex;
+    std::unique_ptr<std::counting_semaphore<>> semaphore;
+};
+
+using Clock = std::chrono::steady_clock;
+
+double microsecondsBetween(Clock::time_point from, Clock::time_point to)
+{
+    return std::chrono::duration<double, std::micro>(to - from).count();
+}
+
+// Tramo máximo de cada espera antes de volver a mirar `stop`
+const std::chrono::milliseconds STOP_CHECK_INTERVAL(1);
+
+// Duerme hasta `deadline` en tramos; false si `stop` se activó antes
+bool sleepUntil(Clock::time_point deadline, const std::atomic<bool> &stop)
+{
+    while (!stop.load(std::memory_order_relaxed)) {
+        Clock::time_point now = Clock::now();
+        if (now >= deadline) return true;
+        std::this_thread::sleep_until(std::min(deadline, now + STOP_CHECK_INTERVAL));
+    }
+    return false;
+}
+
+}
+
+RealThreadRunner::RealThreadRunner(RealPrimitive primitive,
+                                   std::vector<int> permitsPerResource,
+                                   std::chrono::microseconds cycleLength)
+    : primitive(primitive), permits(std::move(permitsPerResource)), cycleLength(cycleLength)
+{
+}
+
+RealThreadReport RealThreadRunner::run(const std::vector<RealThreadJob> &jobs, int processCount,
+                                       const std::atomic<bool> &stop) const
+{
+    RealThreadReport report;
+    report.samples.resize(jobs.size());
+    if (jobs.empty()) return report;
+
+    std::vector<std::unique_ptr<RealLock>> locks;
+    locks.reserve(permits.size());
+    for (int count : permits) {
+        auto lock = std::make_unique<RealLock>();
+        if (primitive == RealPrimitive::Semaphore) {
+            lock->semaphore = std::make_unique<std::counting_semaphore<>>(std::max(0, count));
+        }
+        locks.push_back(std::move(lock));
+    }
+
+    // Agrupar los trabajos por proceso, en orden de ciclo
+    std::vector<std::vector<int>> jobsPerProcess(processCount);
+    for (int i = 0; i < int(jobs.size()); ++i) {
+        if (primitive == RealPrimitive::Semaphore && permits[jobs[i].resource] <= 0) {
+            report.skipped++;
+            continue;
+        }
+        jobsPerProcess[jobs[i].process].push_back(i);
+    }
+    for (auto &list : jobsPerProcess) {
+        std::stable_sort(list.begin(), list.end(), [&](int a, int b) {
+            return jobs[a].cycle < jobs[b].cycle;
+        });
+    }
+
+    // Margen para que todos los hilos estén creados antes del ciclo 0
+    const Clock::time_point start = Clock::now() + std::chrono::milliseconds(20);
+
+    auto worker = [&](const std::vector<int> &ownJobs) {
+        for (int index : ownJobs) {
+            const RealThreadJob &job = jobs[index];
+            RealLock &lock = *locks[job.resource];
+
+            if (!sleepUntil(start + cycleLength * job.cycle, stop)) return;
+            Clock::time_point requested = Clock::now();
+
+            // Cada hilo retiene a lo sumo un recurso y lo suelta pronto al pedir `stop`, así que
+            // una adquisición bloqueada no espera más que un tramo
+            if (stop.load(std::memory_order_relaxed)) return;
+            switch (primitive) {
+            case RealPrimitive::Mutex: lock.mutex.lock(); break;
+            case RealPrimitive::Semaphore: lock.semaphore->acquire(); break;
+            case RealPrimitive::SharedMutex:
+                if (job.write) lock.sharedMutex.lock();
+                else lock.sharedMutex.lock_shared();
+                break;
+            }
+            Clock::time_point granted = Clock::now();
+
+            bool completed = sleepUntil(granted + cycleLength * job.holdCycles, stop);
+
+            switch (primitive) {
+            case RealPrimitive::Mutex: lock.mutex.unlock(); break;
+            case RealPrimitive::Semaphore: lock.semaphore->release(); break;
+            case RealPrimitive::SharedMutex:
+                if (job.write) lock.sharedMutex.unlock();
+                else lock.sharedMutex.unlock_shared();
+                break;
+            }
+
+            // Cada hilo escribe solo las muestras de sus propios trabajos
+            report.samples[index].requestedAtUs = microsecondsBetween(start, requested);
+            report.samples[index].latencyUs = microsecondsBetween(requested, granted);
+            if (!completed) return;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(processCount);
+    for (const auto &ownJobs : jobsPerProcess) {
+        if (!ownJobs.empty()) {
+            threads.emplace_back(worker, std::cref(ownJobs));
+        }
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    Clock::time_point end = Clock::now();
+    report.stopped = stop.load();
+
+    std::vector<double> latencies;
+    latencies.reserve(report.samples.size());
+    for (const RealThreadSample &sample : report.samples) {
+        if (sample.latencyUs >= 0) latencies.push_back(sample.latencyUs);
+    }
+    std::sort(latencies.begin(), latencies.end());
+    if (latencies.empty()) return report;   // Todo fue sobre recursos sin permisos
+
+    report.wallTimeMs = microsecondsBetween(start, end) / 1000.0;
+    report.acquisitionsPerSecond = report.wallTimeMs > 0 ? latencies.size() / (report.wallTimeMs / 1000.0) : 0.0;
+    report.meanLatencyUs = std::accumulate(latencies.begin(), latencies.end(), 0.0) / latencies.size();
+    report.p99LatencyUs = latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)];
+    report.maxLatencyUs = latencies.back();
+    return report;
+}
@@ -0,0 +1,64 @@
+#ifndef REALTHREADRUNNER_H
+#define REALTHREADRUNNER_H
+
+#include <vector>
+#include <chrono>
+#include <atomic>
+
+// Primitiva real que protege cada recurso
+enum class RealPrimitive {
+    Mutex,          // std::mutex
+    Semaphore,      // std::counting_semaphore con los permisos del recurso
+    SharedMutex     // std::shared_mutex: READ compartido, WRITE exclusivo
+};
+
+// Una acción del archivo traducida a índices, lista para ejecutarse en un hilo
+struct RealThreadJob {
+    int process;        // Índice del proceso (un hilo por proceso)
+    int resource;       // Índice del recurso
+    bool write;
+    int cycle;          // Ciclo en el que el proceso pide el recurso
+    int holdCycles;     // Ciclos que retiene el recurso
+};
+
+// Medición de una adquisición real, en el mismo orden que los trabajos de entrada
+struct RealThreadSample {
+    double requestedAtUs = -1;  // Momento real de la petición desde el inicio
+    double latencyUs = -1;      // Tiempo bloqueado esperando la primitiva; -1 si nunca se concedió
+};
+
+struct RealThreadReport {
+    std::vector<RealThreadSample> samples;
+    int skipped = 0;        // Trabajos sobre recursos sin permisos, que no se ejecutan
+    double wallTimeMs = 0.0;
+    double acquisitionsPerSecond = 0.0;
+    double meanLatencyUs = 0.0;
+    double p99LatencyUs = 0.0;
+    double maxLatencyUs = 0.0;
+    bool stopped = false;   // Se cortó con `stop`; las muestras pendientes quedan en -1
+};
+
+// Ejecuta los trabajos sobre std::thread reales: cada proceso es un hilo que espera
+// a su ciclo (cycleLength de tiempo real por ciclo), adquiere la primitiva del recurso,
+// la retiene holdCycles ciclos y la libera. En modo semáforo un recurso con 0 permisos nunca
+// se concede, igual que en el simulador: sus trabajos no se ejecutan ni bloquean al hilo.
+// run() bloquea hasta que terminan todos los hilos; la ventana lo llama desde un hilo aparte.
+// Al activarse `stop`, cada hilo suelta lo que retiene y no pide nada más: las esperas duermen
+// en tramos cortos y lo revisan, así que run() vuelve en pocos milisegundos.
+class RealThreadRunner
+{
+public:
+    RealThreadRunner(RealPrimitive primitive,
+                     std::vector<int> permitsPerResource,
+                     std::chrono::microseconds cycleLength);
+
+    RealThreadReport run(const std::vector<RealThreadJob> &jobs, int processCount,
+                         const std::atomic<bool> &stop) const;
+
+private:
+    RealPrimitive primitive;
+    std::vector<int> permits;
+    std::chrono::microseconds cycleLength;
+};
+
+#endif // REALTHREADRUNNER_H
@@ -0,0 +1,252 @@
+#include "realtimescheduler.h"
+#include "siminstrumentation.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <functional>
+#include <memory_resource>
+#include <numeric>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct Job {
+    long long key;      // Plazo absoluto (EDF) o periodo (RM); menor es más urgente
+    int release;
+    int task;
+    int remaining;
+    int firstStart;     // -1 mientras no corrió
+    long long deadline; // Plazo absoluto; LLONG_MAX si la tarea no tiene plazo
+};
+
+// Orden del montículo de listos: el más urgente arriba, luego el más antiguo y el de menor índice
+bool lessUrgent(const Job &a, const Job &b)
+{
+    if (a.key != b.key) return a.key > b.key;
+    if (a.release != b.release) return a.release > b.release;
+    return a.task > b.task;
+}
+
+int relativeDeadline(const Proceso &p)
+{
+    return p.deadline > 0 ? p.deadline : p.periodo;
+}
+
+// Prioridad fija de RM: el periodo; sin periodo, el plazo; sin ninguno, al fondo
+long long rateMonotonicKey(const Proceso &p)
+{
+    if (p.periodo > 0) return p.periodo;
+    if (p.deadline > 0) return p.deadline;
+    return LLONG_MAX;
+}
+
+// Última llegada más un hiperperiodo; si el hiperperiodo es enorme se recorta, porque el
+// Gantt dibuja toda la corrida
+int automaticHorizon(const QVector<Proceso> &procesos, bool &capped)
+{
+    long long hyperperiod = 1;
+    int lastArrival = 0;
+    capped = false;
+    for (const Proceso &p : procesos) {
+        lastArrival = std::max(lastArrival, p.AT);
+        if (p.periodo <= 0 || capped) continue;
+        hyperperiod = std::lcm(hyperperiod, (long long)p.periodo);
+        capped = hyperperiod > REALTIME_MAX_HORIZON;
+    }
+    return lastArrival + int(capped ? REALTIME_MAX_HORIZON : hyperperiod);
+}
+
+// Promedios y orden de los valores por trabajo, como computeScheduleMetrics
+void finishJobMetrics(RealTimeResult &result)
+{
+    ScheduleMetrics &metrics = result.jobMetrics;
+    metrics.processes = metrics.completion.size();
+    metrics.totalCycles = result.totalCycles;
+    metrics.busyCycles = result.busyCycles;
+    if (metrics.processes > 0) {
+        metrics.avgCompletion = std::accumulate(metrics.completion.begin(), metrics.completion.end(), 0.0) / metrics.processes;
+        metrics.avgTurnaround = std::accumulate(metrics.turnaround.begin(), metrics.turnaround.end(), 0.0) / metrics.processes;
+        metrics.avgResponse = std::accumulate(metrics.response.begin(), metrics.response.end(), 0.0) / metrics.processes;
+    }
+    std::sort(metrics.completion.begin(), metrics.completion.end());
+    std::sort(metrics.turnaround.begin(), metrics.turnaround.end());
+    std::sort(metrics.response.begin(), metrics.response.end());
+}
+
+}
+
+RealTimeResult simulateRealTime(const QVector<Proceso> &procesos, const RealTimeConfig &config)
+{
+    RealTimeResult result;
+    result.horizon = config.horizon > 0 ? config.horizon : automaticHorizon(procesos, result.horizonCapped);
+
+    // Los montículos viven en una arena que se libera de una vez al terminar la corrida
+    std::pmr::monotonic_buffer_resource arena;
+
+    // Próxima liberación de cada tarea: (ciclo, tarea); nunca hay más de una por tarea
+    using Release = std::pair<int, int>;
+    std::pmr::vector<Release> pending(&arena);
+    pending.reserve(procesos.size());
+    std::priority_queue<Release, std::pmr::vector<Release>, std::greater<Release>> releases(
+        std::greater<Release>(), std::move(pending));
+    for (int i = 0; i < procesos.size(); ++i) {
+        releases.push({procesos[i].AT, i});
+    }
+
+    std::pmr::vector<Job> ready(&arena);
+    ready.reserve(procesos.size());
+    int now = 0;
+
+    auto release = [&](int task, int at) {
+        const Proceso &p = procesos[task];
+        int deadline = relativeDeadline(p);
+        Job job;
+        job.release = at;
+        job.task = task;
+        job.remaining = p.BT;
+        job.firstStart = -1;
+        job.deadline = deadline > 0 ? (long long)at + deadline : LLONG_MAX;
+        job.key = config.policy == RealTimePolicy::EDF ? job.deadline : rateMonotonicKey(p);
+        ready.push_back(job);
+        std::push_heap(ready.begin(), ready.end(), lessUrgent);
+        result.releasedJobs++;
+        result.jobsByTask[p.PID]++;
+
+        if (p.periodo > 0 && (long long)at + p.periodo < result.horizon) {
+            releases.push({at + p.periodo, task});
+        }
+    };
+
+    while (!releases.empty() || !ready.empty()) {
+        while (!releases.empty() && releases.top().first <= now) {
+            auto [at, task] = releases.top();
+            releases.pop();
+            release(task, at);
+        }
+        if (ready.empty()) {
+            now = releases.top().first;
+            continue;
+        }
+
+        // El trabajo más urgente corre hasta terminar o hasta la próxima liberación
+        Job &job = ready.front();
+        SIM_TALLY(result.decisions);
+        int nextRelease = releases.empty() ? INT_MAX : releases.top().first;
+        int run = int(std::min<long long>(job.remaining, (long long)nextRelease - now));
+        if (run > 0) {
+            if (job.firstStart == -1) job.firstStart = now;
+            result.timeline.append(procesos[job.task].PID, now, run);
+            now += run;
+            job.remaining -= run;
+            result.busyCycles += run;
+        }
+
+        if (job.remaining == 0) {
+            // Un trabajo de BT 0 termina al liberarse sin correr
+            int start = job.firstStart == -1 ? now : job.firstStart;
+            ScheduleMetrics &metrics = result.jobMetrics;
+            metrics.completion.append(now - job.release);
+            metrics.turnaround.append(now - start);
+            metrics.response.append(start - job.release);
+            if (job.deadline != LLONG_MAX) {
+                long long late = now - job.deadline;
+                result.jobsWithDeadline++;
+                result.lateness.append(int(std::clamp<long long>(late, INT_MIN, INT_MAX)));
+                if (late > 0) {
+                    result.missedDeadlines++;
+                    result.missedByTask[procesos[job.task].PID]++;
+                }
+            }
+            std::pop_heap(ready.begin(), ready.end(), lessUrgent);
+            ready.pop_back();
+        }
+    }
+
+    std::sort(result.lateness.begin(), result.lateness.end());
+    result.totalCycles = now;
+    finishJobMetrics(result);
+    return result;
+}
+
+SchedulabilityReport analyzeSchedulability(const QVector<Proceso> &procesos, RealTimePolicy policy)
+{
+    SchedulabilityReport report;
+    std::vector<int> periodic;
+    bool deadlinesWithinPeriod = true;  // D <= T en todas las tareas
+    bool deadlinesCoverPeriod = true;   // D >= T en todas las tareas
+    double density = 0;
+    for (int i = 0; i < procesos.size(); ++i) {
+        const Proceso &p = procesos[i];
+        if (p.periodo <= 0) continue;
+        int deadline = relativeDeadline(p);
+        periodic.push_back(i);
+        report.utilization += double(p.BT) / p.periodo;
+        density += double(p.BT) / std::max(1, std::min(deadline, p.periodo));
+        deadlinesWithinPeriod = deadlinesWithinPeriod && deadline <= p.periodo;
+        deadlinesCoverPeriod = deadlinesCoverPeriod && deadline >= p.periodo;
+    }
+    report.periodicTasks = int(periodic.size());
+    int n = report.periodicTasks;
+
+    if (policy == RealTimePolicy::EDF) {
+        report.utilizationBound = 1;
+        if (deadlinesCoverPeriod || report.utilization > 1) {
+            report.method = "Utilización (U <= 1)";
+            report.schedulable = report.utilization <= 1;
+            report.exact = true;
+        } else {
+            report.method = "Densidad (suma BT / min(D, T) <= 1)";
+            report.schedulable = density <= 1;
+            report.exact = false;
+        }
+        return report;
+    }
+
+    report.utilizationBound = n > 0 ? n * (std::pow(2.0, 1.0 / n) - 1) : 1;
+    if (!deadlinesWithinPeriod) {
+        report.method = "Cota de Liu y Layland";
+        report.schedulable = report.utilization <= report.utilizationBound;
+        report.exact = report.utilization > 1;
+        return report;
+    }
+
+    // Análisis de tiempo de respuesta en orden de prioridad: R = C + suma(ceil(R / Tj) * Cj).
+    // Supone el instante crítico (todas liberan juntas); con llegadas escalonadas ese
+    // instante puede no ocurrir y un rechazo no es concluyente, salvo con U > 1.
+    bool simultaneous = std::all_of(periodic.begin(), periodic.end(), [&](int i) {
+        return procesos[i].AT == procesos[periodic.front()].AT;
+    });
+    report.method = "Tiempo de respuesta";
+    report.exact = simultaneous || report.utilization > 1;
+    report.schedulable = true;
+    std::stable_sort(periodic.begin(), periodic.end(), [&procesos](int a, int b) {
+        return procesos[a].periodo < procesos[b].periodo;
+    });
+    for (int k = 0; k < n; ++k) {
+        const Proceso &task = procesos[periodic[k]];
+        long long deadline = relativeDeadline(task);
+        long long response = task.BT;
+        while (true) {
+            long long next = task.BT;
+            for (int j = 0; j < k; ++j) {
+                const Proceso &higher = procesos[periodic[j]];
+                next += (response + higher.periodo - 1) / higher.periodo * higher.BT;
+            }
+            if (next == response || next > deadline) {
+                response = next;
+                break;
+            }
+            response = next;
+        }
+        report.responseTimes[task.PID] = int(std::min<long long>(response, INT_MAX));
+        if (response > deadline) report.schedulable = false;
+    }
+    return report;
+}
+
+int latenessPercentile(const RealTimeResult &result, int pct)
+{
+    return sortedPercentile(result.lateness, pct);
+}
@@ -0,0 +1,71 @@
+#ifndef REALTIMESCHEDULER_H
+#define REALTIMESCHEDULER_H
+
+#include <QString>
+#include <QVector>
+#include <QMap>
+#include "schedulingtypes.h"
+#include "schedulemetrics.h"
+#include "timeline.h"
+
+enum class RealTimePolicy {
+    EDF,            // Earliest Deadline First: el plazo absoluto más cercano
+    RateMonotonic   // Prioridad fija: el periodo más corto
+};
+
+// Tope del horizonte automático: el Gantt dibuja la corrida entera
+const int REALTIME_MAX_HORIZON = 10000;
+
+struct RealTimeConfig {
+    RealTimePolicy policy = RealTimePolicy::EDF;
+    int horizon = 0;    // Fin de las liberaciones periódicas; 0 = última llegada más un hiperperiodo
+                        // de hasta REALTIME_MAX_HORIZON ciclos
+};
+
+struct RealTimeResult {
+    Timeline timeline;          // Uso de CPU; los dueños son los PID
+    int totalCycles = 0;
+    int busyCycles = 0;
+    int horizon = 0;
+    bool horizonCapped = false; // El hiperperiodo no cabía en el horizonte automático
+    int releasedJobs = 0;
+    int jobsWithDeadline = 0;
+    int missedDeadlines = 0;
+    QMap<QString, int> jobsByTask;
+    QMap<QString, int> missedByTask;
+    QVector<int> lateness;      // Fin menos plazo de cada trabajo con plazo, ordenado
+    // Las métricas de la ventana, pero por trabajo y con la liberación en lugar de AT: una tarea
+    // periódica libera varios trabajos con el mismo PID y cada uno cuenta aparte
+    ScheduleMetrics jobMetrics;
+    int decisions = 0;          // Elecciones del trabajo más urgente; 0 sin instrumentación
+};
+
+// Prueba de planificabilidad de las tareas periódicas del conjunto
+struct SchedulabilityReport {
+    int periodicTasks = 0;
+    double utilization = 0;         // Suma de BT / periodo
+    double utilizationBound = 1;    // 1 para EDF; n(2^(1/n) - 1) para RM
+    bool schedulable = false;       // Se garantiza que ningún trabajo pierde su plazo
+    bool exact = false;             // Si es false y no es planificable, la prueba no es concluyente
+    QString method;
+    QMap<QString, int> responseTimes;   // RM: peor tiempo de respuesta por tarea
+};
+
+// Simula trabajos con plazo con EDF o RM expropiativos. Una tarea con periodo libera un
+// trabajo en AT, AT + periodo, ... mientras no pase el horizonte; sin periodo libera uno
+// solo. El plazo es relativo a cada liberación (por defecto igual al periodo). Las colas de
+// listos y de liberaciones son montículos y la simulación salta de evento en evento, así que
+// el costo es O(trabajos log tareas) independiente de la duración de las ráfagas.
+// Un trabajo que pierde su plazo sigue corriendo hasta terminar; su retraso queda registrado.
+RealTimeResult simulateRealTime(const QVector<Proceso> &procesos, const RealTimeConfig &config);
+
+// EDF con plazos iguales o mayores al periodo: exacta (U <= 1). Con plazos menores usa la
+// densidad, que solo es suficiente. RM con plazos hasta el periodo: análisis de tiempo de
+// respuesta, exacto si todas las tareas tienen el mismo AT y solo suficiente con llegadas
+// escalonadas; con plazos mayores al periodo, la cota de Liu y Layland.
+SchedulabilityReport analyzeSchedulability(const QVector<Proceso> &procesos, RealTimePolicy policy);
+
+// Percentil del retraso por rango más cercano; 0 si no hubo trabajos con plazo
+int latenessPercentile(const RealTimeResult &result, int pct);
+
+#endif // REALTIMESCHEDULER_H
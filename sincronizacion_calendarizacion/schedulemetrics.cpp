@@ -0,0 +1,60 @@
+#include "schedulemetrics.h"
+#include <QSet>
+#include <algorithm>
+
+ScheduleMetrics computeScheduleMetrics(const Timeline &timeline, const QVector<Proceso> &procesos)
+{
+    // Indexado por dueño de la línea de tiempo; los procesos que nunca corrieron quedan en 0 y -1
+    QVector<int> finalizacion(timeline.ownerCount(), 0);
+    QVector<int> inicioEjecucion(timeline.ownerCount(), -1);
+    timeline.forEach([&](const Timeline::Segment &segmento) {
+        if (inicioEjecucion[segmento.owner] == -1) inicioEjecucion[segmento.owner] = segmento.start;
+        finalizacion[segmento.owner] = segmento.end();
+    });
+
+    ScheduleMetrics metrics;
+    metrics.totalCycles = timeline.end();
+    metrics.busyCycles = timeline.busyTime();
+    metrics.completion.reserve(procesos.size());
+    metrics.turnaround.reserve(procesos.size());
+    metrics.response.reserve(procesos.size());
+
+    // De atrás hacia adelante, así gana la última aparición de cada PID
+    QSet<QString> vistos;
+    long long totalCompletion = 0;
+    long long totalTurnaround = 0;
+    long long totalResponse = 0;
+    for (auto it = procesos.crbegin(); it != procesos.crend(); ++it) {
+        const Proceso &p = *it;
+        if (vistos.contains(p.PID)) continue;
+        vistos.insert(p.PID);
+
+        int dueno = timeline.find(p.PID);
+        int fin = dueno == -1 ? 0 : finalizacion[dueno];
+        int inicio = dueno == -1 ? -1 : inicioEjecucion[dueno];
+        metrics.completion.append(fin - p.AT);
+        metrics.turnaround.append(fin - inicio);
+        metrics.response.append(inicio - p.AT);
+        totalCompletion += fin - p.AT;
+        totalTurnaround += fin - inicio;
+        totalResponse += inicio - p.AT;
+    }
+
+    metrics.processes = metrics.completion.size();
+    if (metrics.processes > 0) {
+        metrics.avgCompletion = double(totalCompletion) / metrics.processes;
+        metrics.avgTurnaround = double(totalTurnaround) / metrics.processes;
+        metrics.avgResponse = double(totalResponse) / metrics.processes;
+    }
+    std::sort(metrics.completion.begin(), metrics.completion.end());
+    std::sort(metrics.turnaround.begin(), metrics.turnaround.end());
+    std::sort(metrics.response.begin(), metrics.response.end());
+    return metrics;
+}
+
+int sortedPercentile(const QVector<int> &sorted, int pct)
+{
+    if (sorted.isEmpty()) return 0;
+    int index = std::clamp(int((sorted.size() * pct + 99) / 100) - 1, 0, int(sorted.size()) - 1);
+    return sorted[index];
+}
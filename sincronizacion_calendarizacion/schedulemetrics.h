@@ -0,0 +1,29 @@
+#ifndef SCHEDULEMETRICS_H
+#define SCHEDULEMETRICS_H
+
+#include <QVector>
+#include "schedulingtypes.h"
+#include "timeline.h"
+
+// Métricas por proceso de un Gantt de CPU:
+//   completion = fin - AT, turnaround = fin - primer inicio, response = primer inicio - AT.
+// Un PID repetido cuenta una vez, con su última aparición. Un proceso que nunca corrió
+// queda con fin 0 y primer inicio -1, igual que en la ventana.
+struct ScheduleMetrics {
+    int processes = 0;
+    int totalCycles = 0;        // Fin del último tramo
+    int busyCycles = 0;
+    double avgCompletion = 0;
+    double avgTurnaround = 0;
+    double avgResponse = 0;
+    QVector<int> completion;    // Valores por proceso, ordenados (para los percentiles)
+    QVector<int> turnaround;
+    QVector<int> response;
+};
+
+ScheduleMetrics computeScheduleMetrics(const Timeline &timeline, const QVector<Proceso> &procesos);
+
+// Percentil por rango más cercano de valores ya ordenados; 0 si está vacío
+int sortedPercentile(const QVector<int> &sorted, int pct);
+
+#endif // SCHEDULEMETRICS_H
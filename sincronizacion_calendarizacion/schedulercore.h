@@ -0,0 +1,474 @@
+#ifndef SCHEDULERCORE_H
+#define SCHEDULERCORE_H
+
+#include <QHash>
+#include <algorithm>
+#include <climits>
+#include <deque>
+#include <functional>
+#include <memory_resource>
+#include <tuple>
+#include <vector>
+#include "cpusyncengine.h"
+#include "schedulerpolicies.h"
+#include "siminstrumentation.h"
+
+// Núcleo de eventos discretos común a todos los algoritmos: llegadas, ráfagas de CPU y E/S,
+// recursos y fusión de tramos. Lo único que cambia entre algoritmos es la política de la cola
+// de listos, que se fija en compilación; agregar un algoritmo es escribir una política.
+// Todo el estado temporal de una corrida vive en una arena que se libera de una vez al
+// destruir el núcleo, así que decidir no reserva memoria del montículo.
+template <typename Policy>
+class SchedulerCore
+{
+public:
+    SchedulerCore(const QVector<Proceso> &procesos, const Policy &policy,
+                  const QVector<Action> &actions, const QMap<QString, int> &capacity)
+        : arena(arenaSize(procesos, actions)),
+          readyPool(&arena),
+          procesos(procesos),
+          ready(policy, &readyPool),
+          states(&arena),
+          bursts(&arena),
+          requests(&arena),
+          permits(&arena),
+          queues(&arena),
+          deviceBusyUntil(&arena),
+          deviceQueues(&arena),
+          arrivalOrder(&arena),
+          timelineOwner(&arena),
+          events(&arena)
+    {
+        int burstTotal = 0;
+        for (const Proceso &p : procesos) burstTotal += std::max(1, int(p.rafagas.size()));
+        states.reserve(procesos.size());
+        timelineOwner.reserve(procesos.size());
+        bursts.reserve(burstTotal);
+        // Cada proceso tiene a lo sumo un evento pendiente: una E/S o un recurso en uso
+        events.reserve(procesos.size());
+
+        QHash<QString, int> processIndex;
+        QHash<QString, int> deviceIndex;
+        for (int i = 0; i < procesos.size(); ++i) {
+            const Proceso &p = procesos[i];
+            processIndex.insert(p.PID, i);
+            timelineOwner.push_back(result.timeline.intern(p.PID));
+            CpuProcess state;
+            state.priority = p.priority;
+            state.lastAging = p.AT;
+            state.firstBurst = int(bursts.size());
+            if (p.rafagas.isEmpty()) {
+                bursts.push_back({CPU, p.BT});
+            }
+            for (const Rafaga &rafaga : p.rafagas) {
+                if (rafaga.dispositivo.isEmpty()) {
+                    bursts.push_back({CPU, rafaga.duracion});
+                    continue;
+                }
+                auto device = deviceIndex.find(rafaga.dispositivo);
+                if (device == deviceIndex.end()) {
+                    device = deviceIndex.insert(rafaga.dispositivo, int(deviceQueues.size()));
+                    deviceBusyUntil.push_back(-1);
+                    deviceQueues.emplace_back();
+                    deviceNames.append(rafaga.dispositivo);
+                    result.deviceBusy[rafaga.dispositivo] = 0;
+                    result.deviceWait[rafaga.dispositivo] = 0;
+                }
+                bursts.push_back({device.value(), rafaga.duracion});
+            }
+            state.burstCount = int(bursts.size()) - state.firstBurst;
+            state.burstLength = bursts[state.firstBurst].length;
+            state.remaining = state.burstLength;
+            states.push_back(state);
+        }
+
+        // Las peticiones de cada proceso quedan contiguas y ordenadas por ciclo de CPU
+        QHash<QString, int> resourceIndex;
+        std::pmr::vector<std::pair<int, int>> owners(&arena);    // (proceso, recurso) de cada acción
+        owners.reserve(actions.size());
+        for (const Action &action : actions) {
+            auto process = processIndex.find(action.PID);
+            if (process == processIndex.end()) {
+                owners.push_back({-1, -1});
+                continue;
+            }
+
+            auto resource = resourceIndex.find(action.resource);
+            if (resource == resourceIndex.end()) {
+                resource = resourceIndex.insert(action.resource, int(permits.size()));
+                permits.push_back(std::max(0, capacity.value(action.resource, 1)));
+                queues.emplace_back();
+            }
+            owners.push_back({process.value(), resource.value()});
+            states[process.value()].requestCount++;
+        }
+        int offset = 0;
+        for (CpuProcess &state : states) {
+            state.firstRequest = offset;
+            offset += state.requestCount;
+        }
+        requests.resize(offset);
+        std::pmr::vector<int> filled(states.size(), 0, &arena);
+        for (int i = 0; i < actions.size(); ++i) {
+            auto [process, resource] = owners[i];
+            if (process == -1) continue;
+            requests[states[process].firstRequest + filled[process]++] =
+                ResourceRequest{resource, actions[i].cycle, std::max(1, actions[i].holdCycles)};
+        }
+        for (const CpuProcess &state : states) {
+            auto first = requests.begin() + state.firstRequest;
+            std::stable_sort(first, first + state.requestCount,
+                             [](const ResourceRequest &a, const ResourceRequest &b) { return a.cpuOffset < b.cpuOffset; });
+        }
+
+        arrivalOrder.resize(procesos.size());
+        for (int i = 0; i < procesos.size(); ++i) arrivalOrder[i] = i;
+        std::stable_sort(arrivalOrder.begin(), arrivalOrder.end(),
+                         [&procesos](int a, int b) { return procesos[a].AT < procesos[b].AT; });
+    }
+
+    CpuSyncResult run()
+    {
+        const int total = procesos.size();
+        while (result.finishedProcesses < total) {
+            admitUntil(now);
+            ready.age(states, now);
+
+            // Un proceso que pide un recurso deja la CPU y se elige otro
+            int chosen = ready.pick(states);
+            SIM_TALLY(result.decisions);
+            while (chosen != -1 && !acquirePending(chosen)) {
+                chosen = ready.pick(states);
+                SIM_TALLY(result.decisions);
+            }
+
+            if (chosen == -1) {
+                // CPU ociosa hasta la próxima llegada o el próximo evento
+                int next = nextEventTime();
+                // Sin eventos pendientes lo que queda espera un recurso sin permisos
+                if (next == INT_MAX) break;
+
+                int idle = next - now;
+                result.idleCycles += idle;
+                if (blockedCount > 0) result.idleWhileBlocked += idle;
+                now = next;
+                continue;
+            }
+
+            int slice = sliceLength(chosen);
+            // Lo que ocurre mientras corre el tramo entra a las colas antes de que termine
+            admitUntil(now + slice - 1);
+            execute(chosen, slice);
+        }
+
+        result.totalCycles = now;
+        for (int i = 0; i < total; ++i) {
+            if (states[i].burst < states[i].burstCount) result.unfinished << procesos[i].PID;
+            // Quien sigue esperando un recurso sin permisos queda bloqueado hasta el final del Gantt
+            if (states[i].blockedSince != -1 && states[i].blockedSince < now) {
+                result.blockedSegments.append({procesos[i].PID, states[i].blockedSince, now - states[i].blockedSince});
+            }
+        }
+        result.cpuIoOverlap = computeOverlap();
+        return result;
+    }
+
+private:
+    static constexpr int CPU = -1;
+
+    struct Burst {
+        int device;     // CPU o índice del dispositivo de E/S
+        int length;
+    };
+
+    struct ResourceRequest {
+        int resource;
+        int cpuOffset;  // Ciclos de CPU ejecutados cuando se pide el recurso
+        int hold;       // Ciclos de uso fuera de la CPU
+    };
+
+    // Las ráfagas y las peticiones de todos los procesos están en dos vectores planos;
+    // cada proceso guarda dónde empieza su tramo y cuántas tiene
+    struct CpuProcess {
+        int firstBurst = 0;
+        int burstCount = 0;
+        int burst = 0;          // Ráfaga actual, relativa a firstBurst
+        int burstLength = 0;    // Duración de la ráfaga de CPU actual
+        int remaining = 0;      // Ciclos que faltan de la ráfaga de CPU actual
+        int executed = 0;
+        int priority;
+        int lastAging;
+        int firstRequest = 0;
+        int requestCount = 0;
+        int nextRequest = 0;    // Relativa a firstRequest
+        int blockedSince = -1;
+        int queuedSince = -1;   // Ciclo en que entró a la cola de un dispositivo
+    };
+
+    enum EventKind { ResourceReleased, IoCompleted };
+
+    // Evento futuro: (ciclo, tipo, proceso, recurso o dispositivo), el menor ciclo primero
+    using Event = std::tuple<int, int, int, int>;
+
+    // Reserva inicial de la arena para que la corrida entera quepa en un solo bloque
+    static std::size_t arenaSize(const QVector<Proceso> &procesos, const QVector<Action> &actions)
+    {
+        std::size_t burstTotal = 0;
+        for (const Proceso &p : procesos) burstTotal += std::max(1, int(p.rafagas.size()));
+        return 4096 + procesos.size() * (sizeof(CpuProcess) + sizeof(Event) + 2 * sizeof(int)) +
+               burstTotal * sizeof(Burst) + actions.size() * (sizeof(ResourceRequest) + sizeof(int));
+    }
+
+    // La arena se declara primero para que se destruya después de todo lo que reparte.
+    // La cola de listos usa un pool encima porque Round Robin la recorre sin fin y los
+    // bloques que suelta deben volver a usarse; el resto solo crece durante la corrida.
+    std::pmr::monotonic_buffer_resource arena;
+    std::pmr::unsynchronized_pool_resource readyPool;
+    const QVector<Proceso> &procesos;
+    ReadyQueue<Policy> ready;
+    std::pmr::vector<CpuProcess> states;
+    std::pmr::vector<Burst> bursts;
+    std::pmr::vector<ResourceRequest> requests;
+    std::pmr::vector<int> permits;
+    std::pmr::vector<std::pmr::deque<int>> queues;
+    std::pmr::vector<int> deviceBusyUntil;          // -1 si el dispositivo está libre
+    std::pmr::vector<std::pmr::deque<int>> deviceQueues;
+    QStringList deviceNames;
+    std::pmr::vector<int> arrivalOrder;
+    std::pmr::vector<int> timelineOwner;            // Dueño de cada proceso en result.timeline
+    std::pmr::vector<Event> events;                 // Montículo de mínimos con std::greater
+    CpuSyncResult result;
+    int nextArrival = 0;
+    int blockedCount = 0;
+    int now = 0;
+
+    const ResourceRequest *pendingRequest(const CpuProcess &state) const
+    {
+        if (state.nextRequest == state.requestCount) return nullptr;
+        return &requests[state.firstRequest + state.nextRequest];
+    }
+
+    void pushEvent(const Event &event)
+    {
+        events.push_back(event);
+        std::push_heap(events.begin(), events.end(), std::greater<Event>());
+    }
+
+    Event popEvent()
+    {
+        std::pop_heap(events.begin(), events.end(), std::greater<Event>());
+        Event event = events.back();
+        events.pop_back();
+        return event;
+    }
+
+    int nextEventTime() const
+    {
+        int next = INT_MAX;
+        if (nextArrival < int(arrivalOrder.size())) next = procesos[arrivalOrder[nextArrival]].AT;
+        if (!events.empty()) next = std::min(next, std::get<0>(events.front()));
+        return next;
+    }
+
+    // Procesa en orden las llegadas y los eventos hasta el ciclo `limit`; en un mismo ciclo
+    // las llegadas van primero
+    void admitUntil(int limit)
+    {
+        const int total = procesos.size();
+        while (true) {
+            int arrival = nextArrival < total ? procesos[arrivalOrder[nextArrival]].AT : INT_MAX;
+            int event = events.empty() ? INT_MAX : std::get<0>(events.front());
+            int at = std::min(arrival, event);
+            if (at > limit) return;
+
+            while (nextArrival < total && procesos[arrivalOrder[nextArrival]].AT == at) {
+                int arrived = arrivalOrder[nextArrival++];
+                if (states[arrived].burstCount == 1 && states[arrived].remaining <= 0) {
+                    states[arrived].burst = 1;
+                    result.finishedProcesses++;
+                } else {
+                    ready.push(states, arrived);
+                }
+            }
+            while (!events.empty() && std::get<0>(events.front()) == at) {
+                auto [cycle, kind, process, target] = popEvent();
+                if (kind == ResourceReleased) {
+                    ready.push(states, process);
+                    release(target, cycle);
+                } else {
+                    finishIo(process, target, cycle);
+                }
+            }
+        }
+    }
+
+    // Ciclos que el proceso puede correr sin que cambie ninguna decisión del algoritmo
+    int sliceLength(int process) const
+    {
+        const CpuProcess &state = states[process];
+        int slice = std::min(state.remaining, ready.sliceLimit(states, now));
+        if (const ResourceRequest *request = pendingRequest(state)) {
+            slice = std::min(slice, request->cpuOffset - state.executed);
+        }
+        if constexpr (Policy::preemptive) {
+            // Una llegada o un regreso a la cola de listos puede desalojar al que corre
+            slice = std::min(slice, nextEventTime() - now);
+        }
+        return std::max(1, slice);
+    }
+
+    // Pide el recurso que toca en este punto de la ejecución; false si el proceso deja la CPU
+    bool acquirePending(int process)
+    {
+        CpuProcess &state = states[process];
+        const ResourceRequest *request = pendingRequest(state);
+        if (!request || request->cpuOffset > state.executed) return true;
+
+        ready.release();
+        if (permits[request->resource] > 0 && queues[request->resource].empty()) {
+            startUse(process, request->resource, now);
+        } else {
+            queues[request->resource].push_back(process);
+            state.blockedSince = now;
+            blockedCount++;
+        }
+        return false;
+    }
+
+    void startUse(int process, int resource, int at)
+    {
+        CpuProcess &state = states[process];
+        permits[resource]--;
+        pushEvent({at + pendingRequest(state)->hold, ResourceReleased, process, resource});
+        state.nextRequest++;
+    }
+
+    void release(int resource, int at)
+    {
+        permits[resource]++;
+        std::pmr::deque<int> &queue = queues[resource];
+        while (permits[resource] > 0 && !queue.empty()) {
+            int waiter = queue.front();
+            queue.pop_front();
+
+            CpuProcess &state = states[waiter];
+            result.blockedSegments.append({procesos[waiter].PID, state.blockedSince, at - state.blockedSince});
+            result.blockedCycles[procesos[waiter].PID] += at - state.blockedSince;
+            state.blockedSince = -1;
+            blockedCount--;
+            startUse(waiter, resource, at);
+        }
+    }
+
+    // El proceso pasa a la ráfaga siguiente: a la cola de listos o a la de un dispositivo
+    void advanceBurst(int process, int at)
+    {
+        CpuProcess &state = states[process];
+        state.burst++;
+        if (state.burst == state.burstCount) {
+            result.finishedProcesses++;
+            return;
+        }
+
+        const Burst &next = bursts[state.firstBurst + state.burst];
+        if (next.device == CPU) {
+            state.burstLength = next.length;
+            state.remaining = next.length;
+            ready.push(states, process);
+            return;
+        }
+
+        state.queuedSince = at;
+        deviceQueues[next.device].push_back(process);
+        if (deviceBusyUntil[next.device] == -1) startIo(next.device, at);
+    }
+
+    // El dispositivo atiende a la cabeza de su cola hasta terminar su ráfaga
+    void startIo(int deviceIndex, int at)
+    {
+        std::pmr::deque<int> &queue = deviceQueues[deviceIndex];
+        int process = queue.front();
+        queue.pop_front();
+
+        CpuProcess &state = states[process];
+        int length = bursts[state.firstBurst + state.burst].length;
+        const QString &name = deviceNames[deviceIndex];
+        result.deviceWait[name] += at - state.queuedSince;
+        result.deviceBusy[name] += length;
+        result.deviceSegments[name].append({procesos[process].PID, at, length});
+
+        deviceBusyUntil[deviceIndex] = at + length;
+        pushEvent({at + length, IoCompleted, process, deviceIndex});
+    }
+
+    void finishIo(int process, int deviceIndex, int at)
+    {
+        deviceBusyUntil[deviceIndex] = -1;
+        if (!deviceQueues[deviceIndex].empty()) startIo(deviceIndex, at);
+        advanceBurst(process, at);
+    }
+
+    void execute(int process, int cycles)
+    {
+        CpuProcess &state = states[process];
+        result.timeline.append(timelineOwner[process], now, cycles);
+        result.busyCycles += cycles;
+        state.executed += cycles;
+        state.remaining -= cycles;
+        now += cycles;
+
+        if (state.remaining == 0) {
+            ready.release();
+            advanceBurst(process, now);
+        } else {
+            ready.charge(cycles);
+        }
+    }
+
+    // Ciclos en que la CPU trabaja mientras algún dispositivo también lo hace
+    int computeOverlap()
+    {
+        std::pmr::vector<std::pair<int, int>> io(&arena);
+        for (auto it = result.deviceSegments.begin(); it != result.deviceSegments.end(); ++it) {
+            for (const ResultadoSimulacion &segment : it.value()) {
+                io.push_back({segment.inicio, segment.inicio + segment.duracion});
+            }
+        }
+        std::sort(io.begin(), io.end());
+
+        // Unión de los tramos de E/S
+        std::pmr::vector<std::pair<int, int>> merged(&arena);
+        for (const auto &interval : io) {
+            if (!merged.empty() && interval.first <= merged.back().second) {
+                merged.back().second = std::max(merged.back().second, interval.second);
+            } else {
+                merged.push_back(interval);
+            }
+        }
+
+        // Los tramos de CPU ya están ordenados y no se solapan
+        int overlap = 0;
+        std::size_t j = 0;
+        result.timeline.forEach([&](const Timeline::Segment &segment) {
+            int start = segment.start;
+            int end = segment.end();
+            while (j < merged.size() && merged[j].second <= start) j++;
+            for (std::size_t k = j; k < merged.size() && merged[k].first < end; ++k) {
+                overlap += std::min(end, merged[k].second) - std::max(start, merged[k].first);
+            }
+        });
+        return overlap;
+    }
+};
+
+// Corre la simulación completa con la política `policy`; sin acciones solo calendariza CPU y E/S
+template <typename Policy>
+CpuSyncResult runScheduler(const QVector<Proceso> &procesos, const Policy &policy,
+                           const QVector<Action> &actions = QVector<Action>(),
+                           const QMap<QString, int> &capacity = QMap<QString, int>())
+{
+    SchedulerCore<Policy> core(procesos, policy, actions, capacity);
+    return core.run();
+}
+
+#endif // SCHEDULERCORE_H
@@ -0,0 +1,194 @@
+#ifndef SCHEDULERPOLICIES_H
+#define SCHEDULERPOLICIES_H
+
+#include <algorithm>
+#include <climits>
+#include <deque>
+#include <memory_resource>
+#include <vector>
+#include "selectkernels.h"
+
+// Políticas de la cola de listos. Cada una es un tipo que el núcleo recibe como parámetro
+// de plantilla, así que el comparador se expande en el ciclo principal sin despacho virtual.
+// Una política declara:
+//   ordered     false: se atiende en orden de llegada; true: gana la menor key()
+//   preemptive  si un proceso listo mejor desaloja al que corre
+//   quantum()   ciclos antes de volver al final de la cola; 0 sin cuanto
+//   key()       clave entera del proceso, menor es mejor (solo si ordered)
+//   age() y agingDeadline() si cambia prioridades con el tiempo (aging = true)
+// Los procesos exponen burstLength (ráfaga de CPU actual), remaining (lo que le falta),
+// priority y lastAging.
+
+struct FifoPolicy {
+    static constexpr bool ordered = false;
+    static constexpr bool preemptive = false;
+    static constexpr bool aging = false;
+    int quantum() const { return 0; }
+};
+
+struct RoundRobinPolicy {
+    static constexpr bool ordered = false;
+    static constexpr bool preemptive = false;
+    static constexpr bool aging = false;
+    int slice = 2;
+    int quantum() const { return std::max(1, slice); }
+};
+
+// SJF no expropiativo: la ráfaga de CPU más corta
+struct ShortestBurstPolicy {
+    static constexpr bool ordered = true;
+    static constexpr bool preemptive = false;
+    static constexpr bool aging = false;
+    int quantum() const { return 0; }
+    template <typename Task>
+    int key(const Task &task) const { return task.burstLength; }
+};
+
+// SRT: lo que le falta a la ráfaga de CPU actual, expropiativo
+struct ShortestRemainingPolicy {
+    static constexpr bool ordered = true;
+    static constexpr bool preemptive = true;
+    static constexpr bool aging = false;
+    int quantum() const { return 0; }
+    template <typename Task>
+    int key(const Task &task) const { return task.remaining; }
+};
+
+// Prioridad expropiativa (1 es la más alta) que mejora en uno cada `interval` ciclos en la cola
+struct AgingPriorityPolicy {
+    static constexpr bool ordered = true;
+    static constexpr bool preemptive = true;
+    static constexpr bool aging = true;
+    int interval = 5;
+    int quantum() const { return 0; }
+    template <typename Task>
+    int key(const Task &task) const { return task.priority; }
+    template <typename Task>
+    void age(Task &task, int now) const
+    {
+        if (now - task.lastAging >= interval) {
+            task.priority = std::max(1, task.priority - 1);
+            task.lastAging = now;
+        }
+    }
+    template <typename Task>
+    int agingDeadline(const Task &task) const { return task.lastAging + interval; }
+};
+
+// Cola de listos y proceso en CPU gobernados por una política. Los procesos se identifican
+// por su índice en el contenedor del motor, que se pasa a cada operación.
+// Con una política ordenada la cola guarda índices y claves en dos arreglos paralelos en
+// orden de llegada: elegir es buscar el primer mínimo de las claves con firstMinIndex(),
+// sin tocar los procesos. La clave de un proceso en cola solo cambia con el aging, y el
+// ciclo en que le toca envejecer va en un tercer arreglo para no recorrer los procesos.
+template <typename Policy>
+class ReadyQueue
+{
+public:
+    // Los nodos de la cola salen de `memory`; el calendarizador en línea usa el montículo
+    explicit ReadyQueue(const Policy &policy = Policy(),
+                        std::pmr::memory_resource *memory = std::pmr::get_default_resource())
+        : policy(policy), queue(memory), ids(memory), keys(memory), agingAt(memory) {}
+
+    template <typename Tasks>
+    void push(const Tasks &tasks, int task)
+    {
+        if constexpr (Policy::ordered) {
+            ids.push_back(task);
+            keys.push_back(policy.key(tasks[task]));
+            if constexpr (Policy::aging) agingAt.push_back(policy.agingDeadline(tasks[task]));
+        } else {
+            queue.push_back(task);
+        }
+    }
+
+    int running() const { return current; }
+    bool idle() const { return current == -1 && queue.empty() && ids.empty(); }
+
+    // El proceso en CPU la deja por terminar su ráfaga o por bloquearse
+    void release() { current = -1; }
+
+    // Elige quién usa la CPU ahora; -1 si nadie. El proceso en CPU gana los empates.
+    template <typename Tasks>
+    int pick(const Tasks &tasks)
+    {
+        if constexpr (!Policy::ordered) {
+            if (current != -1) return current;
+            if (queue.empty()) return -1;
+            switchTo(queue.front());
+            queue.pop_front();
+            return current;
+        } else {
+            if (current != -1 && !Policy::preemptive) return current;
+
+            int best = firstMinIndex(keys.data(), int(keys.size()));
+            if (best == -1) return current;
+            if (current != -1 && keys[best] >= policy.key(tasks[current])) return current;
+
+            int chosen = ids[best];
+            ids.erase(ids.begin() + best);
+            keys.erase(keys.begin() + best);
+            if constexpr (Policy::aging) agingAt.erase(agingAt.begin() + best);
+            if (current != -1) push(tasks, current);
+            switchTo(chosen);
+            return current;
+        }
+    }
+
+    // Ciclos que puede correr el proceso en CPU sin que la política cambie su decisión;
+    // las llegadas futuras las acota el motor
+    template <typename Tasks>
+    int sliceLimit(const Tasks &tasks, int now) const
+    {
+        int limit = INT_MAX;
+        if (policy.quantum() > 0) limit = policy.quantum() - quantumUsed;
+        if constexpr (Policy::aging) {
+            int soonest = firstMinIndex(agingAt.data(), int(agingAt.size()));
+            if (soonest != -1) limit = std::min(limit, agingAt[soonest] - now);
+            limit = std::min(limit, policy.agingDeadline(tasks[current]) - now);
+        }
+        return std::max(1, limit);
+    }
+
+    template <typename Tasks>
+    void age(Tasks &tasks, int now)
+    {
+        if constexpr (Policy::aging) {
+            for (std::size_t i = 0; i < ids.size(); ++i) {
+                if (agingAt[i] > now) continue;
+                policy.age(tasks[ids[i]], now);
+                keys[i] = policy.key(tasks[ids[i]]);
+                agingAt[i] = policy.agingDeadline(tasks[ids[i]]);
+            }
+            if (current != -1) policy.age(tasks[current], now);
+        }
+    }
+
+    // Cuenta los ciclos corridos; con el cuanto vencido el proceso vuelve al final de la cola
+    void charge(int cycles)
+    {
+        quantumUsed += cycles;
+        // Solo las políticas sin orden tienen cuanto
+        if (policy.quantum() > 0 && current != -1 && quantumUsed >= policy.quantum()) {
+            queue.push_back(current);
+            current = -1;
+        }
+    }
+
+private:
+    Policy policy;
+    std::pmr::deque<int> queue;     // Políticas sin orden
+    std::pmr::vector<int> ids;      // Políticas ordenadas: proceso de cada lugar de la cola
+    std::pmr::vector<int> keys;     // y su clave, en el mismo orden
+    std::pmr::vector<int> agingAt;  // Ciclo en que le toca envejecer (solo con aging)
+    int current = -1;
+    int quantumUsed = 0;
+
+    void switchTo(int task)
+    {
+        current = task;
+        quantumUsed = 0;
+    }
+};
+
+#endif // SCHEDULERPOLICIES_H
@@ -0,0 +1,29 @@
+#ifndef SCHEDULINGTYPES_H
+#define SCHEDULINGTYPES_H
+
+#include <QString>
+#include <QVector>
+
+// Ráfaga de un proceso; sin dispositivo es de CPU
+struct Rafaga {
+    QString dispositivo;
+    int duracion;
+};
+
+struct Proceso {
+    QString PID;
+    int BT;  // Burst Time (total de CPU)
+    int AT;  // Arrival Time
+    int priority; // Prioridad (para otros algoritmos)
+    QVector<Rafaga> rafagas;  // Ráfagas de CPU y E/S alternadas; vacía si solo usa CPU
+    int deadline = 0;   // Plazo relativo a cada llegada; 0 si no tiene
+    int periodo = 0;    // Periodo de una tarea periódica; 0 si llega una sola vez
+};
+
+struct ResultadoSimulacion {
+    QString PID;
+    int inicio;
+    int duracion;
+};
+
+#endif // SCHEDULINGTYPES_H
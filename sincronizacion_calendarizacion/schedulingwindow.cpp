@@ -1,15 +1,21 @@
 #include "schedulingwindow.h"
 #include "ui_schedulingwindow.h"
+#include "schedulercore.h"
+#include "schedulemetrics.h"
+#include "diagnosticsdialog.h"
 #include <QFileDialog>
-#include <QFile>
-#include <QTextStream>
-#include <QDebug>
 #include <QGraphicsTextItem>  // Para QGraphicsTextItem
 #include <QGraphicsRectItem>  // Para QGraphicsRectItem
 #include <QPen>               // Para QPen
 #include <QBrush>
-#include <QQueue>
 #include <QMessageBox>
+#include <QHelpEvent>
+#include <QToolTip>
+#include <QSignalBlocker>
+#include <QStatusBar>
+#include <memory>
+#include <algorithm>
+#include <cmath>
 
 SchedulingWindow::SchedulingWindow(QWidget *parent)
     : QMainWindow(parent), ui(new Ui::SchedulingWindow)
@@ -33,10 +39,40 @@ SchedulingWindow::SchedulingWindow(QWidget *parent)
     // Configurar la escena para el diagrama de Gantt
     escenaGantt = new QGraphicsScene(this);
     ui->graphicsView->setScene(escenaGantt);
+    // Tooltips del Gantt: se responden consultando la línea de tiempo de la fila
+    ui->graphicsView->viewport()->installEventFilter(this);
+
+    // Un temporizador para todas las filas; el control de tiempo mueve la fila en curso
+    timerAnimacion = new QTimer(this);
+    connect(timerAnimacion, &QTimer::timeout, this, &SchedulingWindow::avanzarAnimacion);
+    connect(ui->sliderTiempo, &QSlider::valueChanged, this, &SchedulingWindow::onTiempoCambiado);
+    ui->sliderTiempo->setEnabled(false);
 
     // Conectar botones a sus slots
     connect(ui->btnCargarArchivo, &QPushButton::clicked, this, &SchedulingWindow::onCargarArchivoClicked);
     connect(ui->btnEjecutarSimulacion, &QPushButton::clicked, this, &SchedulingWindow::onEjecutarSimulacionClicked);
+    connect(ui->btnCargarAcciones, &QPushButton::clicked, this, &SchedulingWindow::onCargarAccionesClicked);
+    connect(ui->btnCargarRecursos, &QPushButton::clicked, this, &SchedulingWindow::onCargarRecursosClicked);
+    connect(ui->btnDiagnostico, &QPushButton::clicked, this, &SchedulingWindow::onDiagnosticoClicked);
+    perfil.addRate("decisiones_por_s", "decisiones", "motor");
+
+    // Los archivos se leen en un hilo aparte; el progreso y el botón de cancelar van en la barra de estado
+    cargador = new FileLoader(this);
+    statusBar()->addPermanentWidget(new LoadProgressPanel(cargador, this));
+    connect(cargador, &FileLoader::started, this, [this]() {
+        ui->btnEjecutarSimulacion->setEnabled(false);
+    });
+    connect(cargador, &FileLoader::finished, this, [this](bool completada, const QString &error) {
+        ui->btnEjecutarSimulacion->setEnabled(true);
+        if (!error.isEmpty()) {
+            registro.log(LogLevel::Error, error);
+        } else if (!completada) {
+            registro.log(LogLevel::Info, "Carga cancelada; se conservan los datos anteriores");
+        }
+    });
+
+    // Sin vista de registro: los mensajes salen por depuración en lotes
+    volcadoRegistro = new LogFlusher(registro, nullptr, 200, this);
 }
 
 
@@ -47,65 +83,145 @@ void SchedulingWindow::ejecutarProximaSimulacion() {
     } else {
         // todas las simulaciones han terminao
         disconnect(this, &SchedulingWindow::simulacionTerminada, nullptr, nullptr);
+        permitirCarga(true);
     }
 }
 
-//parseo del archivo txt separado por comas
-void SchedulingWindow::parsearArchivo(const QString &contenido) {
-    procesos.clear();
-    QStringList lineas = contenido.split('\n', Qt::SkipEmptyParts);
+// Mientras se animan las filas, las métricas y los carriles de E/S siguen leyendo `procesos`
+// y `dispositivosES`: cargar otro archivo a mitad de la corrida mezclaría dos cargas
+void SchedulingWindow::permitirCarga(bool permitir) {
+    ui->btnCargarArchivo->setEnabled(permitir);
+    ui->btnCargarAcciones->setEnabled(permitir);
+    ui->btnCargarRecursos->setEnabled(permitir);
+}
 
-    for (const QString &linea : lineas) {
-        QStringList partes = linea.split(',', Qt::SkipEmptyParts);
-        if (partes.size() == 4) {
-            Proceso p;
-            p.PID = partes[0].trimmed();
-            p.BT = partes[1].trimmed().toInt();
-            p.AT = partes[2].trimmed().toInt();
-            p.priority = partes[3].trimmed().toInt();
-            procesos.append(p);
-        }
+namespace {
+
+// El cuadro de texto solo muestra el principio de archivos grandes: llenarlo entero
+// tardaría más que parsearlo
+const int MAX_LINEAS_VISTA = 2000;
+
+struct CargaProcesos {
+    QString contenido;
+    QString vista;
+    int lineasVista = 0;
+    int lineasOmitidas = 0;
+    QVector<Proceso> procesos;
+    QStringList errores;
+};
+
+QString formatearLinea(const QString &line) {
+    QStringList parts = line.split(",");
+    if (parts.size() >= 4) {
+        return QString("PID: %1, BT: %2, AT: %3, Priority: %4\n")
+            .arg(parts[0].trimmed())
+            .arg(parts[1].trimmed())
+            .arg(parts[2].trimmed())
+            .arg(parts[3].trimmed());
     }
+    return line + "\n";
+}
+
+}
 
-    procesosMap.clear();
+// Reúne los dispositivos de E/S de las ráfagas; cada uno tiene su carril en el Gantt
+void SchedulingWindow::indexarProcesos() {
+    dispositivosES.clear();
     for (const Proceso &p : procesos) {
-        procesosMap[p.PID] = p;
+        for (const Rafaga &rafaga : p.rafagas) {
+            if (!rafaga.dispositivo.isEmpty() && !dispositivosES.contains(rafaga.dispositivo)) {
+                dispositivosES << rafaga.dispositivo;
+            }
+        }
     }
+    dispositivosES.sort();
 }
 
 void SchedulingWindow::onCargarArchivoClicked() {
     QString filePath = QFileDialog::getOpenFileName(this, "Abrir archivo de procesos", "", "Archivos de texto (*.txt)");
     if (filePath.isEmpty()) return;
 
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qDebug() << "Error al abrir el archivo";
-        return;
+    // Leer y parsear en el hilo de carga; la ventana solo recibe el resultado completo
+    auto carga = std::make_shared<CargaProcesos>();
+    auto consumir = [carga](const QString &bloque, int primeraLinea) {
+        carga->contenido += bloque; // Guardar el contenido original
+
+        QStringList lineas = bloque.split('\n');
+        if (bloque.endsWith('\n')) lineas.removeLast();
+        for (const QString &line : lineas) {
+            if (carga->lineasVista < MAX_LINEAS_VISTA) {
+                carga->vista += formatearLinea(line);
+                carga->lineasVista++;
+            } else {
+                carga->lineasOmitidas++;
+            }
+        }
+
+        QVector<Proceso> leidos = parseProcesses(bloque, &carga->errores, primeraLinea);
+        carga->procesos += leidos;
+        return int(leidos.size());
+    };
+    auto terminar = [this, carga](const LoadStats &stats) {
+        SIM_TIME(perfil, "lectura_archivo", stats.nanoseconds);
+        contenidoArchivo = std::move(carga->contenido);
+        procesos = std::move(carga->procesos);
+        for (const QString &error : carga->errores) {
+            registro.log(LogLevel::Error, "Error en el archivo de procesos: " + error);
+        }
+        indexarProcesos();
+
+        if (carga->lineasOmitidas > 0) {
+            carga->vista += QString("... (%1 líneas más)\n").arg(carga->lineasOmitidas);
+        }
+        ui->txtContenidoArchivo->setPlainText(carga->vista);
+        registro.log(LogLevel::Info, QString("Cargados %1 procesos (%2 bytes)").arg(procesos.size()).arg(stats.bytes));
+    };
+
+    if (!cargador->start(filePath, consumir, terminar)) {
+        registro.log(LogLevel::Error, "Ya hay un archivo cargándose");
     }
+}
 
-    QTextStream in(&file);
-    QString formattedContent;
-    contenidoArchivo.clear();
+void SchedulingWindow::onCargarAccionesClicked() {
+    QString filePath = QFileDialog::getOpenFileName(this, "Abrir archivo de acciones", "", "Archivos de texto (*.txt)");
+    if (filePath.isEmpty()) return;
 
-    // Leer línea por línea y formatear
-    while (!in.atEnd()) {
-        QString line = in.readLine();
-        contenidoArchivo += line + "\n"; // Guardar el contenido original
+    auto leidas = std::make_shared<QVector<Action>>();
+    auto consumir = [leidas](const QString &bloque, int) {
+        QVector<Action> acciones = parseActions(bloque);
+        *leidas += acciones;
+        return int(acciones.size());
+    };
+    auto terminar = [this, leidas](const LoadStats &stats) {
+        SIM_TIME(perfil, "lectura_archivo", stats.nanoseconds);
+        accionesBloqueo = std::move(*leidas);
+        ui->checkBoxBloqueo->setChecked(!accionesBloqueo.isEmpty());
+        ui->metricsTextEdit->append(QString("Cargadas %1 acciones sobre recursos").arg(accionesBloqueo.size()));
+    };
 
-        QStringList parts = line.split(",");
-        if (parts.size() >= 4) {
-            formattedContent += QString("PID: %1, BT: %2, AT: %3, Priority: %4\n")
-                                    .arg(parts[0].trimmed())
-                                    .arg(parts[1].trimmed())
-                                    .arg(parts[2].trimmed())
-                                    .arg(parts[3].trimmed());
-        } else {
-            formattedContent += line + "\n";
-        }
+    if (!cargador->start(filePath, consumir, terminar)) {
+        registro.log(LogLevel::Error, "Ya hay un archivo cargándose");
     }
+}
 
-    ui->txtContenidoArchivo->setPlainText(formattedContent);
-    file.close();
+// El mismo archivo de recursos que la ventana de sincronización; la política de despertar no aplica
+void SchedulingWindow::onCargarRecursosClicked() {
+    QString filePath = QFileDialog::getOpenFileName(this, "Abrir archivo de recursos", "", "Archivos de texto (*.txt)");
+    if (filePath.isEmpty()) return;
+
+    auto leidos = std::make_shared<QMap<QString, int>>();
+    auto consumir = [leidos](const QString &bloque, int) {
+        return parseResources(bloque, *leidos);
+    };
+    auto terminar = [this, leidos](const LoadStats &stats) {
+        SIM_TIME(perfil, "lectura_archivo", stats.nanoseconds);
+        capacidadRecursos = std::move(*leidos);
+        ui->metricsTextEdit->append(QString("Cargados %1 recursos").arg(capacidadRecursos.size()));
+    };
+
+    if (!cargador->start(filePath, consumir, terminar)) {
+        registro.log(LogLevel::Error, "Ya hay un archivo cargándose");
+    }
 }
 
 void SchedulingWindow::onEjecutarSimulacionClicked() {
@@ -122,17 +238,38 @@ void SchedulingWindow::onEjecutarSimulacionClicked() {
         !ui->checkBoxSJF->isChecked() &&
         !ui->checkBoxSRT->isChecked() &&
         !ui->checkBoxRR->isChecked() &&
-        !ui->checkBoxPriority->isChecked()) {
+        !ui->checkBoxPriority->isChecked() &&
+        !ui->checkBoxEDF->isChecked() &&
+        !ui->checkBoxRM->isChecked()) {
         QMessageBox::warning(this, "Advertencia",
                              "No se ha seleccionado ningún algoritmo.\nSeleccione al menos uno.");
         return;
     }
 
+    bool conBloqueo = ui->checkBoxBloqueo->isChecked();
+    if (conBloqueo && accionesBloqueo.isEmpty()) {
+        QMessageBox::warning(this, "Advertencia",
+                             "No se ha cargado ningún archivo de acciones.\nCargue uno o desactive el bloqueo por recursos.");
+        return;
+    }
+
+    if (registro.enabled(LogLevel::Debug)) {
+        registro.log(LogLevel::Debug, QString("Kernel de selección de la cola de listos: ") + selectKernelName());
+    }
+
     limpiarEscena();
-    qDebug() << "Contenido del archivo:\n" << contenidoArchivo;
+    resumenesEventos.clear();
+    metricasPorTrabajo.clear();
+    segmentosES.clear();
+    segmentosBloqueo.clear();
+    carrilBloqueo = conBloqueo;
+    if (registro.enabled(LogLevel::Debug)) {
+        registro.log(LogLevel::Debug, "Contenido del archivo:\n" + contenidoArchivo);
+    }
 
     ui->metricsTextEdit->clear();
-    parsearArchivo(contenidoArchivo);
+    // Las ráfagas de E/S y el bloqueo solo los simula el motor por eventos
+    bool conEventos = conBloqueo || !dispositivosES.isEmpty();
 
     simulaciones.clear();
     simulacionActual = 0;
@@ -140,7 +277,7 @@ void SchedulingWindow::onEjecutarSimulacionClicked() {
     int heightMul = 1;
 
     if (ui->checkBoxFIFO->isChecked()) {
-        auto resultado = ejecutarFIFO(procesos);
+        auto resultado = conEventos ? ejecutarConEventos(SchedulingAlgorithm::FIFO, "FIFO", conBloqueo) : ejecutarFIFO(procesos);
         simulaciones.append([=]() {
             animarSimulacion(resultado, "FIFO", heightMul);
         });
@@ -148,7 +285,7 @@ void SchedulingWindow::onEjecutarSimulacionClicked() {
 
     if (ui->checkBoxSJF->isChecked()) {
         heightMul +=1;
-        auto resultado = ejecutarSJF(procesos);
+        auto resultado = conEventos ? ejecutarConEventos(SchedulingAlgorithm::SJF, "SJF", conBloqueo) : ejecutarSJF(procesos);
         simulaciones.append([=]() {
             animarSimulacion(resultado, "SJF", heightMul);
         });
@@ -156,7 +293,7 @@ void SchedulingWindow::onEjecutarSimulacionClicked() {
 
     if (ui->checkBoxSRT->isChecked()) {
         heightMul +=1;
-        auto resultado = ejecutarSRT(procesos);
+        auto resultado = conEventos ? ejecutarConEventos(SchedulingAlgorithm::SRT, "SRT", conBloqueo) : ejecutarSRT(procesos);
         simulaciones.append([=]() {
             animarSimulacion(resultado, "SRT", heightMul);
         });
@@ -165,18 +302,37 @@ void SchedulingWindow::onEjecutarSimulacionClicked() {
     if (ui->checkBoxRR->isChecked()) {
         heightMul +=1;
         int quantum = ui->quantumSpinBox->value(); // valor del spinbox
-        auto resultado = ejecutarRR(procesos, quantum);
+        QString nombre = "Round Robin (Q=" + QString::number(quantum) + ")";
+        auto resultado = conEventos ? ejecutarConEventos(SchedulingAlgorithm::RoundRobin, nombre, conBloqueo) : ejecutarRR(procesos, quantum);
         simulaciones.append([=]() {
-            animarSimulacion(resultado, "Round Robin (Q=" + QString::number(quantum) + ")", heightMul);
+            animarSimulacion(resultado, nombre, heightMul);
         });
     }
 
     if (ui->checkBoxPriority->isChecked()) {
         heightMul +=1;
         int intervaloAging = ui->spinBoxAging->value(); //valor del spinbox
-        auto resultado = ejecutarPriorityAging(procesos, intervaloAging);
+        QString nombre = "Priority Aging (T=" + QString::number(intervaloAging) + ")";
+        auto resultado = conEventos ? ejecutarConEventos(SchedulingAlgorithm::PriorityAging, nombre, conBloqueo)
+                                    : ejecutarPriorityAging(procesos, intervaloAging);
+        simulaciones.append([=]() {
+            animarSimulacion(resultado, nombre, heightMul);
+        });
+    }
+
+    if (ui->checkBoxEDF->isChecked()) {
+        heightMul +=1;
+        auto resultado = ejecutarEDF(procesos);
+        simulaciones.append([=]() {
+            animarSimulacion(resultado, "EDF", heightMul);
+        });
+    }
+
+    if (ui->checkBoxRM->isChecked()) {
+        heightMul +=1;
+        auto resultado = ejecutarRM(procesos);
         simulaciones.append([=]() {
-            animarSimulacion(resultado, "Priority Aging (T=" + QString::number(intervaloAging) + ")", heightMul);
+            animarSimulacion(resultado, "Rate Monotonic", heightMul);
         });
     }
 
@@ -186,454 +342,515 @@ void SchedulingWindow::onEjecutarSimulacionClicked() {
     });
 
     if (!simulaciones.isEmpty()) {
+        permitirCarga(false);
         ejecutarProximaSimulacion();
     }
 
 }
 
-QVector<ResultadoSimulacion> SchedulingWindow::ejecutarFIFO(const QVector<Proceso>& procesosOriginales) {
-    QVector<Proceso> procesos = procesosOriginales;
-    QVector<ResultadoSimulacion> resultado;
-
-    std::sort(procesos.begin(), procesos.end(), [](const Proceso &a, const Proceso &b) {
-        return a.AT < b.AT;
-    });
-
-    int tiempoActual = 0;
-    for (const Proceso &p : procesos) {
-        if (tiempoActual < p.AT)
-            tiempoActual = p.AT;
-
-        resultado.append({p.PID, tiempoActual, p.BT});
-        tiempoActual += p.BT;
+// Los cinco algoritmos comparten el núcleo de schedulercore.h; solo cambia la política
+template <typename Policy>
+Timeline SchedulingWindow::ejecutarPolitica(const QVector<Proceso>& procesosOriginales, const Policy& politica) {
+    CpuSyncResult resultado;
+    {
+        SIM_PHASE(perfil, "motor");
+        resultado = runScheduler(procesosOriginales, politica);
     }
+    SIM_COUNT(perfil, "decisiones", resultado.decisions);
+    SIM_COUNT(perfil, "tramos", resultado.timeline.size());
+    return resultado.timeline;
+}
 
-    return resultado;
+Timeline SchedulingWindow::ejecutarFIFO(const QVector<Proceso>& procesosOriginales) {
+    return ejecutarPolitica(procesosOriginales, FifoPolicy());
 }
 
-QVector<ResultadoSimulacion> SchedulingWindow::ejecutarSJF(const QVector<Proceso>& procesosOriginales) {
-    QVector<Proceso> procesos = procesosOriginales;
-    QVector<ResultadoSimulacion> resultado;
+Timeline SchedulingWindow::ejecutarSJF(const QVector<Proceso>& procesosOriginales) {
+    return ejecutarPolitica(procesosOriginales, ShortestBurstPolicy());
+}
 
-    int tiempoActual = 0;
-    QVector<Proceso> procesosPendientes = procesos;
-    QVector<Proceso> disponibles;
+Timeline SchedulingWindow::ejecutarSRT(const QVector<Proceso>& procesosOriginales) {
+    return ejecutarPolitica(procesosOriginales, ShortestRemainingPolicy());
+}
 
-    while (!procesosPendientes.isEmpty()) {
-        // Obtener todos los procesos que han llegado hasta el tiempo actual
-        disponibles.clear();
-        for (int i = 0; i < procesosPendientes.size(); ++i) {
-            if (procesosPendientes[i].AT <= tiempoActual) {
-                disponibles.append(procesosPendientes[i]);
-            }
-        }
+Timeline SchedulingWindow::ejecutarRR(const QVector<Proceso>& procesosOriginales, int quantum) {
+    return ejecutarPolitica(procesosOriginales, RoundRobinPolicy{quantum});
+}
 
-        if (!disponibles.isEmpty()) {
-            // Elegir el proceso con menor tiempo de burst
-            std::sort(disponibles.begin(), disponibles.end(), [](const Proceso &a, const Proceso &b) {
-                return a.BT < b.BT;
-            });
+Timeline SchedulingWindow::ejecutarPriorityAging(const QVector<Proceso>& procesosOriginales, int intervaloAging) {
+    return ejecutarPolitica(procesosOriginales, AgingPriorityPolicy{intervaloAging});
+}
 
-            Proceso elegido = disponibles.first();
+Timeline SchedulingWindow::ejecutarEDF(const QVector<Proceso>& procesosOriginales) {
+    return ejecutarTiempoReal(procesosOriginales, RealTimePolicy::EDF, "EDF");
+}
 
-            // Agregar al resultado
-            resultado.append({elegido.PID, tiempoActual, elegido.BT});
-            tiempoActual += elegido.BT;
+Timeline SchedulingWindow::ejecutarRM(const QVector<Proceso>& procesosOriginales) {
+    return ejecutarTiempoReal(procesosOriginales, RealTimePolicy::RateMonotonic, "Rate Monotonic");
+}
 
-            // Eliminar el proceso elegido de los pendientes
-            for (int i = 0; i < procesosPendientes.size(); ++i) {
-                if (procesosPendientes[i].PID == elegido.PID) {
-                    procesosPendientes.removeAt(i);
-                    break;
-                }
-            }
-        } else {
-            // No hay procesos listos aún, avanzar el tiempo
-            tiempoActual++;
-        }
+Timeline SchedulingWindow::ejecutarTiempoReal(const QVector<Proceso>& tareas, RealTimePolicy politica, const QString& nombreAlgoritmo) {
+    RealTimeConfig config;
+    config.policy = politica;
+    RealTimeResult resultado;
+    {
+        SIM_PHASE(perfil, "motor");
+        resultado = simulateRealTime(tareas, config);
     }
+    SIM_COUNT(perfil, "decisiones", resultado.decisions);
+    SIM_COUNT(perfil, "tramos", resultado.timeline.size());
 
-    return resultado;
-}
+    SIM_PHASE(perfil, "metricas");
+    SchedulabilityReport prueba = analyzeSchedulability(tareas, politica);
 
-QVector<ResultadoSimulacion> SchedulingWindow::ejecutarSRT(const QVector<Proceso>& procesosOriginales) {
-    QVector<ResultadoSimulacion> resultado;
-    QVector<Proceso> procesosPendientes = procesosOriginales;
-
-    int tiempoActual = 0;
-    Proceso* procesoActual = nullptr;
-    QMap<QString, int> tiempoRestante;
-    QMap<QString, Proceso*> procesoMap;  // Mapa para búsqueda rápida
+    QStringList resumen;
+    if (!dispositivosES.isEmpty() || ui->checkBoxBloqueo->isChecked()) {
+        resumen << "Nota: EDF y RM usan el BT total; ignoran la E/S y los recursos";
+    }
+    resumen << QString("Trabajos: %1 (con plazo: %2, horizonte: %3)")
+                   .arg(resultado.releasedJobs)
+                   .arg(resultado.jobsWithDeadline)
+                   .arg(resultado.horizon);
+    if (resultado.horizonCapped) {
+        resumen << QString("Horizonte recortado a %1 ciclos después de la última llegada: el hiperperiodo no se puede dibujar")
+                       .arg(REALTIME_MAX_HORIZON);
+    }
+    resumen << QString("Deadline Miss Rate: %1% (%2 de %3)")
+                   .arg(100.0 * resultado.missedDeadlines / std::max(1, resultado.jobsWithDeadline), 0, 'f', 1)
+                   .arg(resultado.missedDeadlines)
+                   .arg(resultado.jobsWithDeadline);
+    if (!resultado.lateness.isEmpty()) {
+        resumen << QString("Lateness: min %1, p50 %2, p95 %3, p99 %4, max %5")
+                       .arg(resultado.lateness.first())
+                       .arg(latenessPercentile(resultado, 50))
+                       .arg(latenessPercentile(resultado, 95))
+                       .arg(latenessPercentile(resultado, 99))
+                       .arg(resultado.lateness.last());
+    }
 
-    // Inicializar estructuras
-    for (auto& proceso : procesosPendientes) {
-        tiempoRestante[proceso.PID] = proceso.BT;
-        procesoMap[proceso.PID] = &proceso;
+    QStringList perdidos;
+    for (auto it = resultado.missedByTask.begin(); it != resultado.missedByTask.end(); ++it) {
+        perdidos << QString("%1=%2/%3").arg(it.key()).arg(it.value()).arg(resultado.jobsByTask.value(it.key()));
+    }
+    if (!perdidos.isEmpty()) {
+        resumen << "Plazos perdidos por tarea: " + perdidos.join(", ");
     }
 
-    while (!tiempoRestante.isEmpty()) {
-        // Recolectar procesos disponibles
-        QVector<Proceso*> disponibles;
-        for (auto it = tiempoRestante.begin(); it != tiempoRestante.end(); ++it) {
-            Proceso* proc = procesoMap[it.key()];
-            if (proc->AT <= tiempoActual && it.value() > 0) {
-                disponibles.append(proc);
-            }
+    if (prueba.periodicTasks > 0) {
+        QString veredicto = prueba.schedulable ? "planificable"
+                            : prueba.exact ? "no planificable"
+                                           : "no concluyente";
+        resumen << QString("Planificabilidad (%1): U=%2, cota %3 -> %4")
+                       .arg(prueba.method)
+                       .arg(prueba.utilization, 0, 'f', 3)
+                       .arg(prueba.utilizationBound, 0, 'f', 3)
+                       .arg(veredicto);
+        QStringList respuestas;
+        for (auto it = prueba.responseTimes.begin(); it != prueba.responseTimes.end(); ++it) {
+            respuestas << QString("%1=%2").arg(it.key()).arg(it.value());
         }
-
-        if (!disponibles.isEmpty()) {
-            // Ordenar por tiempo restante
-            std::sort(disponibles.begin(), disponibles.end(), [&](Proceso* a, Proceso* b) {
-                return tiempoRestante[a->PID] < tiempoRestante[b->PID];
-            });
-
-            Proceso* elegido = disponibles.first();
-
-            // Manejar cambio de proceso
-            if (!procesoActual || procesoActual->PID != elegido->PID) {
-                resultado.append({elegido->PID, tiempoActual, 1});
-            } else {
-                resultado.last().duracion++;
-            }
-
-            procesoActual = elegido;
-            tiempoRestante[elegido->PID]--;
-
-            // Eliminar si terminó
-            if (tiempoRestante[elegido->PID] == 0) {
-
-                tiempoRestante.remove(elegido->PID);
-            }
-
+        if (!respuestas.isEmpty()) {
+            resumen << "Peor tiempo de respuesta: " + respuestas.join(", ");
         }
-
-        tiempoActual++;
     }
 
-    return resultado;
+    resumenesEventos[nombreAlgoritmo] = resumen;
+    metricasPorTrabajo[nombreAlgoritmo] = resultado.jobMetrics;
+    return resultado.timeline;
 }
 
-QVector<ResultadoSimulacion> SchedulingWindow::ejecutarRR(const QVector<Proceso>& procesosOriginales, int quantum) {
-    QVector<ResultadoSimulacion> resultado;
-    QVector<Proceso> procesos = procesosOriginales;
-    QMap<QString, int> tiempoRestante;
-    QQueue<Proceso*> colaListos;
-    int tiempoActual = 0;
-
-    // Inicializar tiempo restante
-    for (const auto& p : procesos) {
-        tiempoRestante[p.PID] = p.BT;
+Timeline SchedulingWindow::ejecutarConEventos(SchedulingAlgorithm algoritmo, const QString& nombreAlgoritmo, bool conBloqueo) {
+    CpuSyncConfig config;
+    config.algorithm = algoritmo;
+    config.quantum = ui->quantumSpinBox->value();
+    config.agingInterval = ui->spinBoxAging->value();
+    config.capacity = capacidadRecursos;
+
+    CpuSyncResult resultado;
+    {
+        SIM_PHASE(perfil, "motor");
+        resultado = simulateCpuWithBlocking(procesos, conBloqueo ? accionesBloqueo : QVector<Action>(), config);
+    }
+    SIM_COUNT(perfil, "decisiones", resultado.decisions);
+    SIM_COUNT(perfil, "tramos", resultado.timeline.size());
+    segmentosES[nombreAlgoritmo] = resultado.deviceSegments;
+    segmentosBloqueo[nombreAlgoritmo] = resultado.blockedSegments;
+
+    QStringList resumen;
+    int total = std::max(1, resultado.totalCycles);
+    resumen << QString("CPU Utilization: %1% (%2 de %3 ciclos)")
+                   .arg(100.0 * resultado.busyCycles / total, 0, 'f', 1)
+                   .arg(resultado.busyCycles)
+                   .arg(resultado.totalCycles);
+    for (auto it = resultado.deviceBusy.begin(); it != resultado.deviceBusy.end(); ++it) {
+        resumen << QString("%1 Utilization: %2% (espera en cola: %3 ciclos)")
+                       .arg(it.key())
+                       .arg(100.0 * it.value() / total, 0, 'f', 1)
+                       .arg(resultado.deviceWait.value(it.key()));
+    }
+    if (!resultado.deviceBusy.isEmpty()) {
+        resumen << QString("CPU y E/S en paralelo: %1 ciclos").arg(resultado.cpuIoOverlap);
     }
 
-    // Ordenar procesos por tiempo de llegada
-    std::sort(procesos.begin(), procesos.end(), [](const Proceso& a, const Proceso& b) {
-        return a.AT < b.AT;
-    });
-
-    // Índice para nuevos procesos que llegan
-    int nextProceso = 0;
-
-    while (true) {
-        // Agregar procesos que han llegado a la cola de listos
-        while (nextProceso < procesos.size() && procesos[nextProceso].AT <= tiempoActual) {
-            colaListos.enqueue(&procesos[nextProceso]);
-            nextProceso++;
+    if (conBloqueo) {
+        // La misma carga sin recursos sirve de referencia para medir lo que cuesta el bloqueo
+        CpuSyncResult referencia;
+        {
+            SIM_PHASE(perfil, "motor_referencia");
+            referencia = simulateCpuWithBlocking(procesos, QVector<Action>(), config);
         }
+        resumen << QString("CPU ociosa por bloqueo: %1% (%2 ciclos)")
+                       .arg(100.0 * resultado.idleWhileBlocked / total, 0, 'f', 1)
+                       .arg(resultado.idleWhileBlocked);
+        resumen << QString("Duración sin bloqueo: %1 ciclos (+%2 por bloqueo)")
+                       .arg(referencia.totalCycles)
+                       .arg(resultado.totalCycles - referencia.totalCycles);
+    }
 
-        if (colaListos.isEmpty()) {
-            if (nextProceso < procesos.size()) {
-                // No hay procesos listos, avanzar al próximo tiempo de llegada
-                tiempoActual = procesos[nextProceso].AT;
-                continue;
-            } else {
-                // Todos los procesos completados
-                break;
-            }
-        }
+    QStringList bloqueados;
+    for (auto it = resultado.blockedCycles.begin(); it != resultado.blockedCycles.end(); ++it) {
+        bloqueados << QString("%1=%2").arg(it.key()).arg(it.value());
+    }
+    if (!bloqueados.isEmpty()) {
+        resumen << "Ciclos bloqueados: " + bloqueados.join(", ");
+    }
+    if (!resultado.unfinished.isEmpty()) {
+        resumen << "Sin terminar (recurso sin permisos): " + resultado.unfinished.join(", ");
+    }
 
-        Proceso* actual = colaListos.dequeue();
-        int tiempoEjecucion = qMin(quantum, tiempoRestante[actual->PID]);
+    resumenesEventos[nombreAlgoritmo] = resumen;
+    return resultado.timeline;
+}
 
-        // Registrar el segmento de ejecución
-        resultado.append({actual->PID, tiempoActual, tiempoEjecucion});
+void SchedulingWindow::calcularMetricas(const FilaGantt& fila) {
+    SIM_PHASE(perfil, "metricas");
+    // Calcular métricas según las definiciones corroboradas por el estimado Carlos Canteo
+    //El completion time es el tiempo que pasa desde la submision hasta la finalizacion.
+    //El turnaround es el que pasa desde el inicio de la ejecucion hasta la finalizacion
+    //Y el response/wait es el tiempo desde submission hasta el inicio de ejecucion
+    // En EDF y RM cada trabajo de una tarea periódica cuenta aparte, desde su liberación
+    auto porTrabajo = metricasPorTrabajo.constFind(fila.algoritmo);
+    bool esPorTrabajo = porTrabajo != metricasPorTrabajo.constEnd();
+    ScheduleMetrics metricas = esPorTrabajo ? *porTrabajo : computeScheduleMetrics(fila.linea, procesos);
+    if (esPorTrabajo) {
+        ui->metricsTextEdit->append(QString("Métricas por trabajo (%1 trabajos)").arg(metricas.processes));
+    }
 
-        // Actualizar tiempo restante
-        tiempoRestante[actual->PID] -= tiempoEjecucion;
-        tiempoActual += tiempoEjecucion;
+    // Mostrar promedios
+    ui->metricsTextEdit->append("Avg Completion Time: " + QString::number(metricas.avgCompletion));
+    ui->metricsTextEdit->append("Avg Turnaround Time: " + QString::number(metricas.avgTurnaround));
+    ui->metricsTextEdit->append("Avg Waiting Time (Response): " + QString::number(metricas.avgResponse));
+    ui->metricsTextEdit->append("--------------------------------");
+}
 
-        // Agregar procesos que llegaron durante esta ejecución
-        while (nextProceso < procesos.size() && procesos[nextProceso].AT < tiempoActual) {
-            colaListos.enqueue(&procesos[nextProceso]);
-            nextProceso++;
-        }
 
-        // Si el proceso no ha terminado, volver a colocarlo en la cola
-        if (tiempoRestante[actual->PID] > 0) {
-            colaListos.enqueue(actual);
-        }
+void SchedulingWindow::animarSimulacion(const Timeline& resultado, const QString& nombreAlgoritmo, int heightMult) {
+    //limpiarEscena();
+    ui->metricsTextEdit->append("Simulación: " + nombreAlgoritmo);
+    for (const QString &linea : resumenesEventos.value(nombreAlgoritmo)) {
+        ui->metricsTextEdit->append(linea);
     }
 
-    return resultado;
-}
-
-QVector<ResultadoSimulacion> SchedulingWindow::ejecutarPriorityAging(const QVector<Proceso>& procesosOriginales, int intervaloAging) {
-    QVector<ResultadoSimulacion> resultado;
-    QVector<Proceso> procesos = procesosOriginales;
-    std::sort(procesos.begin(), procesos.end(), [](const Proceso& a, const Proceso& b) {
-        return a.AT < b.AT; // Ordenar por tiempo de llegada inicial
-    });
+    // Inicializar variables de animación
+    colorMapAnimacion.clear();
+    colorIndexAnimacion = 0;
+    agregarFila(resultado, nombreAlgoritmo, heightMult);
+    filaAnimada = filasGantt.size() - 1;
 
-    int tiempoActual = 0;
-    QVector<Proceso*> readyQueue;
-    QMap<QString, int> tiempoRestante;
-    QMap<QString, int> prioridadActual; // Prioridad dinámica con aging
-    QMap<QString, int> ultimoAging;    // Cuando se aplicó último aging
+    ui->graphicsView->setScene(escenaGantt);
 
-    // Inicialización
-    for (const auto& p : procesos) {
-        tiempoRestante[p.PID] = p.BT;
-        prioridadActual[p.PID] = p.priority;
-        ultimoAging[p.PID] = p.AT;
+    // El control de tiempo recorre la fila que se está animando
+    {
+        QSignalBlocker bloqueo(ui->sliderTiempo);
+        ui->sliderTiempo->setRange(0, resultado.end());
+        ui->sliderTiempo->setValue(0);
     }
+    ui->sliderTiempo->setEnabled(true);
+    ui->lblTiempo->setText(QString("0 / %1").arg(resultado.end()));
 
-    while (true) {
-        // llegado a la ready queue
-        for (auto& p : procesos) {
-            if (p.AT == tiempoActual) {
-                readyQueue.push_back(&p);
-            }
-        }
+    timerAnimacion->start(400);  // Velocidad de animación (ms)
+}
 
-        // envejecimiento: cada 5 ciclos aumentamos prioridad (disminuimos valor)
-        for (auto& p : readyQueue) {
-            if (tiempoActual - ultimoAging[p->PID] >= intervaloAging) {
-                prioridadActual[p->PID] = std::max(1, prioridadActual[p->PID] - 1);
-                ultimoAging[p->PID] = tiempoActual;
-            }
-        }
+// Carriles bajo cada fila de CPU: uno por dispositivo y, con bloqueo, uno para las esperas
+int SchedulingWindow::carrilesFila() const {
+    return dispositivosES.size() + (carrilBloqueo ? 1 : 0);
+}
 
-        //seleccionar proceso con mayor prioridad, osea el de menor valor. priority 1 es el mas alto
+// Fila nueva debajo de las anteriores, dejando lugar para los carriles de E/S
+SchedulingWindow::FilaGantt& SchedulingWindow::agregarFila(const Timeline& resultado, const QString& nombreAlgoritmo, int heightMult) {
+    // Configuración de espaciado
+    const int BLOCK_HEIGHT = 30;
+    const int VERTICAL_SPACING = 100;  // Espacio entre simulaciones
+    const int BASE_Y_OFFSET = 20;     // Margen superior
+    const int LANE_HEIGHT = BLOCK_HEIGHT + 5;  // Carril de cada dispositivo de E/S
+
+    int carriles = carrilesFila();
+    FilaGantt fila;
+    fila.algoritmo = nombreAlgoritmo;
+    fila.y = BASE_Y_OFFSET + (heightMult - 1) * (VERTICAL_SPACING + carriles * LANE_HEIGHT);
+    fila.linea = resultado;
+    filasGantt.append(fila);
+    return filasGantt.last();
+}
 
-        Proceso* elegido = nullptr;
-        if (!readyQueue.isEmpty()) {
-            std::sort(readyQueue.begin(), readyQueue.end(), [&](Proceso* a, Proceso* b) {
-                return prioridadActual[a->PID] < prioridadActual[b->PID]; // Menor valor = mayor prioridad
-            });
-            elegido = readyQueue.first();
-        }
+void SchedulingWindow::dibujarResultado(const Timeline& resultado, const QString& nombreAlgoritmo, int heightMult) {
+    FilaGantt &fila = agregarFila(resultado, nombreAlgoritmo, heightMult);
+    irACiclo(fila, resultado.end());
+    dibujarPieFila(fila);
+    fila.terminada = true;
+}
 
-        // Ejecutar el proceso elegido o IDLE
-        if (elegido && tiempoRestante[elegido->PID] > 0) {
-            // Continuar o crear nuevo segmento
-            if (!resultado.isEmpty() && resultado.last().PID == elegido->PID) {
-                resultado.last().duracion++;
-            } else {
-                resultado.append({elegido->PID, tiempoActual, 1});
-            }
+// Un ciclo por tick; al llegar al final se dibujan los carriles de E/S y las métricas
+void SchedulingWindow::avanzarAnimacion() {
+    if (filaAnimada < 0 || filaAnimada >= filasGantt.size()) {
+        timerAnimacion->stop();
+        return;
+    }
+    FilaGantt &fila = filasGantt[filaAnimada];
+    if (fila.ciclo >= fila.linea.end()) {
+        terminarFila(fila);
+        return;
+    }
 
-            tiempoRestante[elegido->PID]--;
+    irACiclo(fila, fila.ciclo + 1);
+    QSignalBlocker bloqueo(ui->sliderTiempo);
+    ui->sliderTiempo->setValue(fila.ciclo);
+}
 
-            // Eliminar si terminó
-            if (tiempoRestante[elegido->PID] == 0) {
-                readyQueue.removeAll(elegido);
-            }
-        }
+void SchedulingWindow::onTiempoCambiado(int ciclo) {
+    if (filaAnimada < 0 || filaAnimada >= filasGantt.size()) return;
+    FilaGantt &fila = filasGantt[filaAnimada];
+    if (fila.terminada) return;
+    irACiclo(fila, ciclo);
+}
 
-        // verificar condición de término
-        bool todosTerminados = true;
-        for (const auto& p : procesos) {
-            if (tiempoRestante[p.PID] > 0) {
-                todosTerminados = false;
-                break;
-            }
-        }
-        if (todosTerminados) break;
+// Deja dibujados exactamente los ciclos [0, ciclo) de la fila. Retroceder quita o recorta los
+// bloques sobrantes y avanzar dibuja solo lo que falta: la línea de tiempo salta al bloque de
+// tramos que contiene el ciclo actual y desde ahí decodifica, así que nunca se repite desde cero.
+void SchedulingWindow::irACiclo(FilaGantt& fila, int ciclo) {
+    SIM_PHASE(perfil, "escena");
+    const int BLOCK_WIDTH = 30;
+    const int BLOCK_HEIGHT = 30;
+    ciclo = std::clamp(ciclo, 0, fila.linea.end());
 
-        tiempoActual++;
+    while (!fila.bloques.isEmpty() && fila.bloques.last().inicio >= ciclo) {
+        delete fila.bloques.last().texto;
+        delete fila.bloques.last().rect;
+        fila.bloques.removeLast();
     }
+    if (!fila.bloques.isEmpty() && fila.bloques.last().fin > ciclo) {
+        BloqueGantt &ultimo = fila.bloques.last();
+        ultimo.fin = ciclo;
+        ultimo.rect->setRect(ultimo.inicio * BLOCK_WIDTH, fila.y, (ultimo.fin - ultimo.inicio) * BLOCK_WIDTH, BLOCK_HEIGHT);
+    }
+    fila.ciclo = std::min(fila.ciclo, ciclo);
+
+    int desde = fila.ciclo;
+    fila.linea.forEach(desde, ciclo, [&](const Timeline::Segment& tramo) {
+        // Los huecos entre tramos son ciclos en que la CPU estuvo ociosa
+        if (fila.ciclo < tramo.start) dibujarBloque(fila, tramo.start, -1);
+        dibujarBloque(fila, std::min(tramo.end(), ciclo), tramo.owner);
+    });
+    if (fila.ciclo < ciclo) dibujarBloque(fila, ciclo, -1);
 
-    return resultado;
+    ui->lblTiempo->setText(QString("%1 / %2").arg(fila.ciclo).arg(fila.linea.end()));
 }
 
-void SchedulingWindow::calcularMetricas(const QVector<ResultadoSimulacion>& resultado) {
-    QMap<QString, int> tiempoLlegada;
-    QMap<QString, int> tiempoFinalizacion;
-    QMap<QString, int> tiempoInicioEjecucion;
-    QMap<QString, int> tiempoCPUUsado;
+// Dibuja [fila.ciclo, fin) del mismo dueño: alarga el último bloque si es la continuación del
+// mismo tramo y si no agrega uno nuevo, con su rectángulo y su texto
+void SchedulingWindow::dibujarBloque(FilaGantt& fila, int fin, int dueno) {
+    const int BLOCK_WIDTH = 30;
+    const int BLOCK_HEIGHT = 30;
+    QPen pen(Qt::black);
+    int inicio = fila.ciclo;
+    fila.ciclo = fin;
 
-    // Inicializar con datos de los procesos
-    for (const auto& p : procesosMap) {
-        tiempoLlegada[p.PID] = p.AT;
-        tiempoFinalizacion[p.PID] = 0;
-        tiempoInicioEjecucion[p.PID] = -1;  // -1 indica que no ha iniciado
-        tiempoCPUUsado[p.PID] = 0;
+    if (!fila.bloques.isEmpty() && fila.bloques.last().dueno == dueno && fila.bloques.last().fin == inicio) {
+        BloqueGantt &ultimo = fila.bloques.last();
+        ultimo.fin = fin;
+        ultimo.rect->setRect(ultimo.inicio * BLOCK_WIDTH, fila.y, (fin - ultimo.inicio) * BLOCK_WIDTH, BLOCK_HEIGHT);
+        return;
     }
 
-    // Procesar todos los segmentos
-    for (const auto& segmento : resultado) {
-        // Registrar el primer inicio de ejecución
-        if (tiempoInicioEjecucion[segmento.PID] == -1) {
-            tiempoInicioEjecucion[segmento.PID] = segmento.inicio;
+    int x = inicio * BLOCK_WIDTH;
+    int ancho = (fin - inicio) * BLOCK_WIDTH;
+    BloqueGantt bloque{inicio, fin, dueno, nullptr, nullptr};
+    if (dueno == -1) {
+        bloque.rect = escenaGantt->addRect(x, fila.y, ancho, BLOCK_HEIGHT, pen, QBrush(Qt::lightGray));
+        bloque.texto = escenaGantt->addText("IDLE");
+        bloque.texto->setPos(x, fila.y + 5);
+    } else {
+        QString pid = fila.linea.name(dueno);
+        if (!globalColorMap.contains(pid)) {
+            int colorIndex = globalColorMap.size() % coloresProcesos.size();
+            globalColorMap[pid] = coloresProcesos[colorIndex];
         }
-
-        // El tiempo de finalización es el último segmento
-        tiempoFinalizacion[segmento.PID] = segmento.inicio + segmento.duracion;
-        tiempoCPUUsado[segmento.PID] += segmento.duracion;
+        bloque.rect = escenaGantt->addRect(x, fila.y, ancho, BLOCK_HEIGHT, pen, QBrush(globalColorMap[pid]));
+        bloque.texto = escenaGantt->addText(pid);
+        bloque.texto->setPos(x + 5, fila.y + 5);
     }
+    fila.bloques.append(bloque);
+    SIM_COUNT(perfil, "elementos_escena", 2);
+}
 
-    // Calcular métricas según las definiciones corroboradas por el estimado Carlos Canteo
-    //El completion time es el tiempo que pasa desde la submision hasta la finalizacion.
-    //El turnaround es el que pasa desde el inicio de la ejecucion hasta la finalizacion
-    //Y el response/wait es el tiempo desde submission hasta el inicio de ejecucion
-
-    double totalCompletion = 0;
-    double totalTurnaround = 0;
-    double totalResponse = 0;
-    int numProcesos = procesosMap.size();
-
-    for (const auto& p : procesosMap) {
-        // COMPLETION TIME: desde submission (AT) hasta finalización
-        int completionTime = tiempoFinalizacion[p.PID] - tiempoLlegada[p.PID];
-
-        // TURNAROUND TIME: desde inicio de ejecución hasta finalización
-        int turnaroundTime = tiempoFinalizacion[p.PID] - tiempoInicioEjecucion[p.PID];
-
-        // RESPONSE/WAIT TIME: desde submission (AT) hasta inicio de ejecución
-        int responseTime = tiempoInicioEjecucion[p.PID] - tiempoLlegada[p.PID];
+// Carriles de E/S y números de ciclo, debajo de los bloques de CPU
+void SchedulingWindow::dibujarPieFila(const FilaGantt& fila) {
+    SIM_PHASE(perfil, "escena");
+    const int BLOCK_HEIGHT = 30;
+    const int LANE_HEIGHT = BLOCK_HEIGHT + 5;
+    QPen pen(Qt::black);
 
-        totalCompletion += completionTime;
-        totalTurnaround += turnaroundTime;
-        totalResponse += responseTime;
+    // Carriles de E/S debajo de la CPU, uno por dispositivo
+    int carriles = carrilesFila();
+    QMap<QString, QVector<ResultadoSimulacion>> carrilesES = segmentosES.value(fila.algoritmo);
+    for (int d = 0; d < dispositivosES.size(); ++d) {
+        int yCarril = fila.y + (d + 1) * LANE_HEIGHT;
+        QGraphicsTextItem *nombre = escenaGantt->addText(dispositivosES[d]);
+        nombre->setPos(-70, yCarril + 5);
+        SIM_COUNT(perfil, "elementos_escena", 1);
+        for (const ResultadoSimulacion &segmento : carrilesES.value(dispositivosES[d])) {
+            QColor color = globalColorMap.value(segmento.PID, Qt::white);
+            int x = segmento.inicio * 30;
+            escenaGantt->addRect(x, yCarril, segmento.duracion * 30, BLOCK_HEIGHT, pen, QBrush(color.lighter(130)));
+            QGraphicsTextItem *text = escenaGantt->addText(segmento.PID);
+            text->setPos(x + 5, yCarril + 5);
+            SIM_COUNT(perfil, "elementos_escena", 2);
+        }
+    }
+    if (carrilBloqueo) {
+        dibujarCarrilBloqueo(fila, fila.y + (dispositivosES.size() + 1) * LANE_HEIGHT);
     }
 
-    // Mostrar promedios
-    ui->metricsTextEdit->append("Avg Completion Time: " + QString::number(totalCompletion/numProcesos));
-    ui->metricsTextEdit->append("Avg Turnaround Time: " + QString::number(totalTurnaround/numProcesos));
-    ui->metricsTextEdit->append("Avg Waiting Time (Response): " + QString::number(totalResponse/numProcesos));
-    ui->metricsTextEdit->append("--------------------------------");
+    // Números de ciclo en el inicio de cada bloque de CPU y al final de la fila
+    const int yNumeros = fila.y + BLOCK_HEIGHT + 5 + carriles * LANE_HEIGHT;
+    for (const BloqueGantt &bloque : fila.bloques) {
+        escenaGantt->addText(QString::number(bloque.inicio))->setPos(bloque.inicio * 30, yNumeros);
+    }
+    escenaGantt->addText(QString::number(fila.ciclo))->setPos(fila.ciclo * 30, yNumeros);
+    SIM_COUNT(perfil, "elementos_escena", fila.bloques.size() + 1);
 }
 
-
-void SchedulingWindow::animarSimulacion(const QVector<ResultadoSimulacion>& resultado, const QString& nombreAlgoritmo, int heightMult) {
-    //limpiarEscena();
-    ui->metricsTextEdit->append("Simulación: " + nombreAlgoritmo);
-
-    // Configuración de espaciado
+// Esperas por recurso fuera de la CPU, un rectángulo rayado por tramo. Los tramos que se
+// solapan van en subcarriles que se reparten la altura del carril
+void SchedulingWindow::dibujarCarrilBloqueo(const FilaGantt& fila, int yCarril) {
+    const int BLOCK_WIDTH = 30;
     const int BLOCK_HEIGHT = 30;
-    const int VERTICAL_SPACING = 100;  // Espacio entre simulaciones
-    const int BASE_Y_OFFSET = 20;     // Margen superior
+    QPen pen(Qt::black);
 
-    int yOffset = BASE_Y_OFFSET + (heightMult - 1) * VERTICAL_SPACING;
+    QGraphicsTextItem *nombre = escenaGantt->addText("BLOQUEO");
+    nombre->setPos(-70, yCarril + 5);
+    SIM_COUNT(perfil, "elementos_escena", 1);
 
-    // Inicializar variables de animación
-    cicloAnimacion = 0;
-    xAnimacion = 0;
-    colorMapAnimacion.clear();
-    colorIndexAnimacion = 0;
-    tiemposEsperaAnimacion.clear();
-    tiemposRespuestaAnimacion.clear();
-    indexAnimacion = 0;
-    bloqueActual = 0;  // contador para bloques dentro de un proceso
-    resultadoActual = resultado;
-    procesoActual = nullptr;  // Para rastrear el proceso actual
-    enModoIdle = false;
-
-    // Configuración inicial de la escena
-    QPen pen(Qt::black);
-    //escenaGantt->addLine(0, 30, 1000, 30, pen);
-    ui->graphicsView->setScene(escenaGantt);
+    QVector<ResultadoSimulacion> tramos = segmentosBloqueo.value(fila.algoritmo);
+    std::stable_sort(tramos.begin(), tramos.end(), [](const ResultadoSimulacion& a, const ResultadoSimulacion& b) {
+        return a.inicio < b.inicio;
+    });
 
-    QTimer* timer = new QTimer(this);
-    connect(timer, &QTimer::timeout, this, [=]() {
-
-        if (enModoIdle) {
-            // Dibujar un solo bloque IDLE por tick del timer
-            QGraphicsRectItem *idle = escenaGantt->addRect(xAnimacion, yOffset, 30, BLOCK_HEIGHT, pen, QBrush(Qt::lightGray));
-            QGraphicsTextItem *text = escenaGantt->addText("IDLE");
-            text->setPos(xAnimacion, yOffset + 5);
-            xAnimacion += 30;
-            cicloAnimacion++;
-
-            // Verificar si hemos completado todos los bloques IDLE necesarios
-            if (cicloAnimacion >= procesoActual->inicio) {
-                enModoIdle = false;
-                bloqueActual = 0;
-            }
-            return;
+    // Cada tramo va al primer subcarril que ya quedó libre cuando empieza
+    QVector<int> finSubcarril;
+    QVector<int> subcarril(tramos.size());
+    for (int i = 0; i < tramos.size(); ++i) {
+        int s = 0;
+        while (s < finSubcarril.size() && finSubcarril[s] > tramos[i].inicio) ++s;
+        if (s == finSubcarril.size()) finSubcarril.append(0);
+        finSubcarril[s] = tramos[i].inicio + tramos[i].duracion;
+        subcarril[i] = s;
+    }
+
+    const qreal alto = qreal(BLOCK_HEIGHT) / std::max(1, int(finSubcarril.size()));
+    const bool conTexto = alto >= 20;
+    for (int i = 0; i < tramos.size(); ++i) {
+        const ResultadoSimulacion &tramo = tramos[i];
+        QRectF area(tramo.inicio * BLOCK_WIDTH, yCarril + subcarril[i] * alto, tramo.duracion * BLOCK_WIDTH, alto);
+        QColor color = globalColorMap.value(tramo.PID, Qt::darkGray);
+        escenaGantt->addRect(area, pen, QBrush(color, Qt::BDiagPattern));
+        if (conTexto) {
+            QGraphicsTextItem *text = escenaGantt->addText(tramo.PID);
+            text->setPos(area.x() + 5, area.y() + 5);
         }
+    }
+    SIM_COUNT(perfil, "elementos_escena", (conTexto ? 2 : 1) * tramos.size());
+}
 
-        // Si no hay proceso actual, obtener el siguiente
-        if (procesoActual == nullptr) {
-
-            // esto es al final, cuando ya se pintaron todos
-            if (indexAnimacion >= resultadoActual.size()) {
-                // Dibujar números de ciclo
-                for (int i = 0; i < cicloAnimacion; ++i) {
-                    QGraphicsTextItem *cicloText = escenaGantt->addText(QString::number(i));
-                    cicloText->setPos(i * 30, yOffset + BLOCK_HEIGHT + 5);
-                }
-
-                // Calcular métricas
-                calcularMetricas(resultadoActual);
-
-                timer->stop();
-                timer->deleteLater();
-                // Emitir señal después de limpiar
-                QTimer::singleShot(0, this, [=]() {
-                    emit simulacionTerminada();
-                });
-                return;
-            }
+void SchedulingWindow::terminarFila(FilaGantt& fila) {
+    dibujarPieFila(fila);
 
-            procesoActual = &resultadoActual[indexAnimacion];
+    // Calcular métricas
+    calcularMetricas(fila);
 
-            if (!globalColorMap.contains(procesoActual->PID)) {
-                int colorIndex = globalColorMap.size() % coloresProcesos.size();
-                globalColorMap[procesoActual->PID] = coloresProcesos[colorIndex];
-            }
-
-            // Entrar en modo IDLE si es necesario
-            if (cicloAnimacion < procesoActual->inicio) {
-                enModoIdle = true;
-                return;  // Dejar que el próximo tick maneje el IDLE
-            }
+    fila.terminada = true;
+    timerAnimacion->stop();
+    ui->sliderTiempo->setEnabled(false);
+    // Emitir señal después de limpiar
+    QTimer::singleShot(0, this, [=]() {
+        emit simulacionTerminada();
+    });
+}
 
-            bloqueActual = 0;  // Resetear contador de bloques
-        }
 
-        // Dibujar solo un bloque del proceso actual
-        if (bloqueActual < procesoActual->duracion) {
-            QColor procesoColor = globalColorMap[procesoActual->PID];
-            QGraphicsRectItem *rect = escenaGantt->addRect(xAnimacion, yOffset, 30, BLOCK_HEIGHT, pen, QBrush(procesoColor));
-            QGraphicsTextItem *text = escenaGantt->addText(procesoActual->PID);
-            text->setPos(xAnimacion + 5, yOffset + 5);
-            xAnimacion += 30;
-            cicloAnimacion++;
-            bloqueActual++;
+bool SchedulingWindow::eventFilter(QObject *watched, QEvent *event) {
+    if (event->type() == QEvent::ToolTip && watched == ui->graphicsView->viewport()) {
+        QHelpEvent *ayuda = static_cast<QHelpEvent*>(event);
+        QString texto = textoTooltip(ui->graphicsView->mapToScene(ayuda->pos()));
+        if (texto.isEmpty()) {
+            QToolTip::hideText();
         } else {
-            // Calcular métricas cuando terminamos con este proceso
-            int espera = procesoActual->inicio - procesosMap[procesoActual->PID].AT;
-            int respuesta = procesoActual->inicio + procesoActual->duracion - procesosMap[procesoActual->PID].AT;
-            tiemposEsperaAnimacion.append(espera);
-            tiemposRespuestaAnimacion.append(respuesta);
-
-            // Pasar al siguiente proceso
-            indexAnimacion++;
-            procesoActual = nullptr;
+            QToolTip::showText(ayuda->globalPos(), texto, ui->graphicsView);
         }
-    });
+        return true;
+    }
+    return QMainWindow::eventFilter(watched, event);
+}
 
-    timer->start(400);  // Velocidad de animación (ms)
+// Qué corría en el bloque bajo el cursor; vacío fuera de las filas de CPU
+QString SchedulingWindow::textoTooltip(const QPointF& posicion) const {
+    const int BLOCK_WIDTH = 30;
+    const int BLOCK_HEIGHT = 30;
+    if (posicion.x() < 0) return QString();
+    int ciclo = int(std::floor(posicion.x() / BLOCK_WIDTH));
+
+    for (int i = 0; i < filasGantt.size(); ++i) {
+        const FilaGantt &fila = filasGantt[i];
+        if (posicion.y() < fila.y || posicion.y() >= fila.y + BLOCK_HEIGHT) continue;
+        // La fila en curso puede estar a medio animar: no adelantar lo que aún no se dibuja
+        int limite = fila.terminada ? fila.linea.end() : fila.ciclo;
+        if (ciclo >= limite) return QString();
+
+        Timeline::Segment tramo = fila.linea.segmentAt(ciclo);
+        if (tramo.owner == -1) return QString("%1\nCiclo %2: IDLE").arg(fila.algoritmo).arg(ciclo);
+        return QString("%1\nCiclo %2: %3\nTramo %4-%5 (%6 ciclos)")
+            .arg(fila.algoritmo)
+            .arg(ciclo)
+            .arg(fila.linea.name(tramo.owner))
+            .arg(tramo.start)
+            .arg(tramo.end())
+            .arg(tramo.length);
+    }
+    return QString();
 }
 
+void SchedulingWindow::onDiagnosticoClicked() {
+    if (!diagnostico) {
+        diagnostico = new DiagnosticsDialog(perfil, "calendarizacion", this);
+    }
+    diagnostico->show();
+    diagnostico->raise();
+    diagnostico->refresh();
+}
 
 // aca voy a poner los destructores
 void SchedulingWindow::limpiarEscena() {
+    timerAnimacion->stop();
     escenaGantt->clear();
     globalColorMap.clear();
+    filasGantt.clear();
+    filaAnimada = -1;
+    ui->sliderTiempo->setEnabled(false);
+    ui->lblTiempo->setText("0 / 0");
 }
 
 SchedulingWindow::~SchedulingWindow()
 {
+    ui->graphicsView->viewport()->removeEventFilter(this);
     delete ui;
 }
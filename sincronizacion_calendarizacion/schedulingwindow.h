@@ -7,46 +7,59 @@
 #include <QVector>
 #include <QTimer>
 #include <QMap>
+#include "simlogger.h"
+#include "schedulingtypes.h"
+#include "cpusyncengine.h"
+#include "realtimescheduler.h"
+#include "timeline.h"
+#include "fileloader.h"
+#include "siminstrumentation.h"
+
+class DiagnosticsDialog;
 
 namespace Ui {
 class SchedulingWindow;
 }
 
-struct Proceso {
-    QString PID;
-    int BT;  // Burst Time
-    int AT;  // Arrival Time
-    int priority; // Prioridad (para otros algoritmos)
-};
-
-struct ResultadoSimulacion {
-    QString PID;
-    int inicio;
-    int duracion;
-};
-
 class SchedulingWindow : public QMainWindow {
     Q_OBJECT
 
 public:
     explicit SchedulingWindow(QWidget *parent = nullptr);
     void ejecutarProximaSimulacion();
+    // Dibuja la fila completa de una vez, sin animación ni métricas (benchmark de renderizado)
+    void dibujarResultado(const Timeline& resultado, const QString& nombreAlgoritmo, int heightMult);
+    void limpiarEscena();
     ~SchedulingWindow();
 
+protected:
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
 private slots:
     void onCargarArchivoClicked();
     void onEjecutarSimulacionClicked();
-    QVector<ResultadoSimulacion> ejecutarFIFO(const QVector<Proceso>& procesos);
-    QVector<ResultadoSimulacion> ejecutarSJF(const QVector<Proceso>& procesosOriginales);
-    QVector<ResultadoSimulacion> ejecutarSRT(const QVector<Proceso>& procesosOriginales);
-    QVector<ResultadoSimulacion> ejecutarRR(const QVector<Proceso>& procesosOriginales, int quantum);
-    QVector<ResultadoSimulacion> ejecutarPriorityAging(const QVector<Proceso>& procesosOriginales, int intervaloAging);
+    void onCargarAccionesClicked();
+    void onCargarRecursosClicked();
+    void onDiagnosticoClicked();
+    void onTiempoCambiado(int ciclo);
+    Timeline ejecutarFIFO(const QVector<Proceso>& procesos);
+    Timeline ejecutarSJF(const QVector<Proceso>& procesosOriginales);
+    Timeline ejecutarSRT(const QVector<Proceso>& procesosOriginales);
+    Timeline ejecutarRR(const QVector<Proceso>& procesosOriginales, int quantum);
+    Timeline ejecutarPriorityAging(const QVector<Proceso>& procesosOriginales, int intervaloAging);
+    Timeline ejecutarEDF(const QVector<Proceso>& procesosOriginales);
+    Timeline ejecutarRM(const QVector<Proceso>& procesosOriginales);
 
 private:
     Ui::SchedulingWindow *ui;
     QGraphicsScene *escenaGantt;
     QVector<Proceso> procesos;
     QString contenidoArchivo;
+    SimLogger registro;
+    LogFlusher *volcadoRegistro;
+    FileLoader *cargador;                           // Lectura y parseo de archivos fuera del hilo de la interfaz
+    SimProfile perfil;                              // Tiempos por fase y contadores de la ventana
+    DiagnosticsDialog *diagnostico = nullptr;
     QVector<QColor> coloresProcesos;
 
     int colorIndex;
@@ -54,29 +67,63 @@ private:
     QVector<std::function<void()>> simulaciones;
     int simulacionActual;
 
-    QHash<QString, Proceso> procesosMap;  // Para métricas
+    QVector<Action> accionesBloqueo;                // Acciones sobre recursos del modo combinado
+    QMap<QString, int> capacidadRecursos;           // Permisos por recurso; 1 (mutex) si no aparece
+    QMap<QString, QStringList> resumenesEventos;    // Métricas de bloqueo y E/S por algoritmo
+    QMap<QString, ScheduleMetrics> metricasPorTrabajo;  // EDF y RM: métricas por trabajo, no por PID
+    QMap<QString, QMap<QString, QVector<ResultadoSimulacion>>> segmentosES;  // Carriles de E/S por algoritmo
+    QMap<QString, QVector<ResultadoSimulacion>> segmentosBloqueo;           // Esperas por recurso por algoritmo
+    bool carrilBloqueo = false;                     // La corrida dibuja un carril de bloqueo bajo la CPU
+    QStringList dispositivosES;                     // Dispositivos que aparecen en las ráfagas
 
-    int cicloAnimacion;
-    int xAnimacion;
     QHash<QString, QColor> colorMapAnimacion;
     int colorIndexAnimacion;
-    QVector<int> tiemposEsperaAnimacion;
-    QVector<int> tiemposRespuestaAnimacion;
-    int indexAnimacion;
-    QVector<ResultadoSimulacion> resultadoActual;
-    bool enModoIdle;
 
-    int bloqueActual;                   // Para rastrear bloques dentro de un proceso
-    const ResultadoSimulacion* procesoActual;
-
-    void animarSimulacion(const QVector<ResultadoSimulacion>& resultado, const QString& nombreAlgoritmo, int heightMult);
-    void calcularMetricas(const QVector<ResultadoSimulacion>& resultado);
+    // Bloque dibujado de la CPU: un tramo de la línea de tiempo (o un hueco ocioso) hasta
+    // donde llegó la animación; el rectángulo se alarga mientras el tramo sigue corriendo
+    struct BloqueGantt {
+        int inicio;
+        int fin;
+        int dueno;                          // -1 si la CPU estuvo ociosa
+        QGraphicsRectItem *rect;
+        QGraphicsTextItem *texto;
+    };
+
+    // Fila del Gantt; el tooltip y el control de tiempo consultan su línea de tiempo en vez
+    // de la escena. `bloques` son los bloques de la CPU ya dibujados, uno por tramo y en orden.
+    struct FilaGantt {
+        QString algoritmo;
+        int y;
+        Timeline linea;
+        int ciclo = 0;                      // Ciclos ya dibujados
+        bool terminada = false;
+        QVector<BloqueGantt> bloques;
+    };
+    QVector<FilaGantt> filasGantt;
+    int filaAnimada = -1;                   // Fila que avanza el temporizador, -1 si ninguna
+    QTimer *timerAnimacion;
+
+    void animarSimulacion(const Timeline& resultado, const QString& nombreAlgoritmo, int heightMult);
+    FilaGantt& agregarFila(const Timeline& resultado, const QString& nombreAlgoritmo, int heightMult);
+    void calcularMetricas(const FilaGantt& fila);
+    QString textoTooltip(const QPointF& posicion) const;
+    void avanzarAnimacion();
+    void irACiclo(FilaGantt& fila, int ciclo);
+    void dibujarBloque(FilaGantt& fila, int fin, int dueno);
+    void dibujarPieFila(const FilaGantt& fila);
+    void dibujarCarrilBloqueo(const FilaGantt& fila, int yCarril);
+    int carrilesFila() const;
+    void terminarFila(FilaGantt& fila);
+    Timeline ejecutarTiempoReal(const QVector<Proceso>& tareas, RealTimePolicy politica, const QString& nombreAlgoritmo);
+    Timeline ejecutarConEventos(SchedulingAlgorithm algoritmo, const QString& nombreAlgoritmo, bool conBloqueo);
+    template <typename Policy>
+    Timeline ejecutarPolitica(const QVector<Proceso>& procesosOriginales, const Policy& politica);
 
     QMap<QString, QColor> globalColorMap;
 
     void dibujarDiagramaFIFO();
-    void parsearArchivo(const QString &contenido);
-    void limpiarEscena();
+    void indexarProcesos();
+    void permitirCarga(bool permitir);
 
 signals:
     void simulacionTerminada();
@@ -0,0 +1,403 @@
+#include "scriptengine.h"
+#include <QHash>
+#include <algorithm>
+
+ScriptProgram parseScriptFile(const QString &content)
+{
+    ScriptProgram program;
+    QHash<QString, int> processIndex;
+    QHash<QString, int> resourceIndex;
+    std::vector<std::pair<int, ScriptStep>> entries;
+
+    auto processFor = [&](const QString &pid) {
+        auto found = processIndex.find(pid);
+        if (found != processIndex.end()) return found.value();
+        int index = program.processNames.size();
+        processIndex.insert(pid, index);
+        program.processNames.append(pid);
+        program.startCycle.push_back(0);
+        return index;
+    };
+    auto resourceFor = [&](const QString &name) {
+        auto found = resourceIndex.find(name);
+        if (found != resourceIndex.end()) return found.value();
+        int index = program.resourceNames.size();
+        resourceIndex.insert(name, index);
+        program.resourceNames.append(name);
+        return index;
+    };
+
+    // Formato: PID, START|ACQUIRE|HOLD|RELEASE, argumento
+    QStringList lines = content.split('\n', Qt::SkipEmptyParts);
+    for (const QString &line : lines) {
+        QStringList parts = line.split(',', Qt::SkipEmptyParts);
+        if (parts.size() != 3) continue;
+
+        QString pid = parts[0].trimmed();
+        QString kind = parts[1].trimmed().toUpper();
+        QString argument = parts[2].trimmed();
+        if (pid.isEmpty() || argument.isEmpty()) continue;
+
+        if (kind == "START") {
+            program.startCycle[processFor(pid)] = std::max(0, argument.toInt());
+        } else if (kind == "ACQUIRE" || kind == "LOCK") {
+            int process = processFor(pid);
+            entries.push_back({process, {ScriptStepKind::Acquire, resourceFor(argument)}});
+        } else if (kind == "RELEASE" || kind == "UNLOCK") {
+            int process = processFor(pid);
+            entries.push_back({process, {ScriptStepKind::Release, resourceFor(argument)}});
+        } else if (kind == "HOLD") {
+            int process = processFor(pid);
+            entries.push_back({process, {ScriptStepKind::Hold, std::max(0, argument.toInt())}});
+        }
+    }
+
+    // Agrupar los pasos por proceso con un conteo, conservando el orden del archivo
+    const int processes = program.processCount();
+    program.firstStep.assign(processes + 1, 0);
+    for (const auto &entry : entries) {
+        program.firstStep[entry.first + 1]++;
+    }
+    for (int p = 0; p < processes; ++p) {
+        program.firstStep[p + 1] += program.firstStep[p];
+    }
+
+    std::vector<int> cursor(program.firstStep.begin(), program.firstStep.end() - 1);
+    program.steps.resize(entries.size());
+    for (const auto &entry : entries) {
+        program.steps[cursor[entry.first]++] = entry.second;
+    }
+    return program;
+}
+
+ScriptEngine::ScriptEngine(const ScriptProgram &program, const QMap<QString, int> &capacity, bool keepHistory)
+    : program(program), keepHistory(keepHistory)
+{
+    const int processes = program.processCount();
+    const int resources = program.resourceNames.size();
+
+    permits.resize(resources);
+    for (int r = 0; r < resources; ++r) {
+        permits[r] = std::max(0, capacity.value(program.resourceNames.at(r), 1));
+    }
+    queueHead.assign(resources, -1);
+    queueTail.assign(resources, -1);
+    nextWaiter.assign(processes, -1);
+    waitingSince.assign(processes, -1);
+    pendingAcquisition.assign(processes, -1);
+    held.resize(processes);
+    waitingOn.assign(processes, -1);
+    holders.resize(resources);
+    deadlocked.assign(processes, 0);
+    visitMark.assign(processes, 0);
+    onPath.assign(processes, 0);
+    visitStamp = 0;
+    tasks.resize(processes);
+
+    // La corrutina de cada proceso se crea cuando llega su ciclo de inicio
+    arrivalOrder.resize(processes);
+    for (int p = 0; p < processes; ++p) arrivalOrder[p] = p;
+    std::stable_sort(arrivalOrder.begin(), arrivalOrder.end(), [&program](int a, int b) {
+        return program.startCycle[a] < program.startCycle[b];
+    });
+    nextArrival = 0;
+
+    finishedCount = 0;
+    blockedCycles = 0;
+    currentCycle = 0;
+    started = false;
+}
+
+ScriptEngine::~ScriptEngine()
+{
+    for (std::coroutine_handle<> &task : tasks) {
+        if (task) task.destroy();
+    }
+}
+
+ScriptEngine::ProcessTask ScriptEngine::runProcess(int process)
+{
+    const int end = program.firstStep[process + 1];
+    for (int s = program.firstStep[process]; s < end; ++s) {
+        const ScriptStep current = program.steps[s];
+        if (current.kind == ScriptStepKind::Acquire) {
+            co_await AcquireAwaiter{*this, process, current.argument};
+        } else if (current.kind == ScriptStepKind::Hold) {
+            co_await HoldAwaiter{*this, process, current.argument};
+        } else {
+            release(process, current.argument);
+        }
+    }
+
+    // Un proceso que termina suelta lo que todavía retiene
+    releaseAll(process);
+}
+
+bool ScriptEngine::step()
+{
+    if (started) {
+        currentCycle++;
+    }
+    started = true;
+
+    // Los procesos despertados por un RELEASE se agregan al final y corren en este mismo ciclo
+    ready.clear();
+    while (nextArrival < arrivalOrder.size() &&
+           program.startCycle[arrivalOrder[nextArrival]] <= currentCycle) {
+        ready.push_back(arrivalOrder[nextArrival++]);
+    }
+    wakeups.takeDue(currentCycle, ready);
+    for (std::size_t i = 0; i < ready.size(); ++i) {
+        resume(ready[i]);
+    }
+
+    // Sin llegadas ni despertares pendientes nadie más puede avanzar: los que quedan están bloqueados
+    return nextArrival == arrivalOrder.size() && wakeups.empty();
+}
+
+ScriptRunResult ScriptEngine::runToCompletion()
+{
+    while (!step()) {}
+
+    ScriptRunResult result;
+    result.finalCycle = currentCycle;
+    result.finishedProcesses = finishedCount;
+    result.totalBlockedCycles = blockedCycles;
+    for (int p = 0; p < program.processCount(); ++p) {
+        if (waitingSince[p] != -1) {
+            result.blockedProcesses.push_back(p);
+            result.totalBlockedCycles += currentCycle + 1 - waitingSince[p];
+        }
+    }
+    result.acquisitions = acquisitions;
+    result.deadlocks = foundDeadlocks;
+    result.starvations = foundStarvations;
+    return result;
+}
+
+void ScriptEngine::resume(int process)
+{
+    std::coroutine_handle<> &task = tasks[process];
+    if (!task) {
+        task = runProcess(process).handle;
+    }
+
+    task.resume();
+    if (task.done()) {
+        task.destroy();
+        task = nullptr;
+        finishedCount++;
+    }
+}
+
+int ScriptEngine::recordRequest(int process, int resource, bool waiting)
+{
+    Action action;
+    action.PID = program.processNames.at(process);
+    action.action = "ACQUIRE";
+    action.resource = program.resourceNames.at(resource);
+    action.cycle = currentCycle;
+    action.holdCycles = 1;
+    action.completed = !waiting;
+    action.completionCycle = waiting ? -1 : currentCycle;
+    action.waitingSince = waiting ? currentCycle : -1;
+    action.realWaitCycles = -1;
+    acquisitions.append(action);
+    return acquisitions.size() - 1;
+}
+
+bool ScriptEngine::tryAcquire(int process, int resource)
+{
+    // Respetar el orden de llegada: con cola no vacía el permiso es del primero en ella
+    if (permits[resource] == 0 || queueHead[resource] != -1) return false;
+
+    permits[resource]--;
+    addHolder(process, resource, keepHistory ? recordRequest(process, resource, false) : -1);
+    return true;
+}
+
+void ScriptEngine::enqueueWaiter(int process, int resource)
+{
+    waitingSince[process] = currentCycle;
+    waitingOn[process] = resource;
+    pendingAcquisition[process] = keepHistory ? recordRequest(process, resource, true) : -1;
+
+    nextWaiter[process] = -1;
+    if (queueTail[resource] == -1) {
+        queueHead[resource] = process;
+    } else {
+        nextWaiter[queueTail[resource]] = process;
+    }
+    queueTail[resource] = process;
+
+    detectDeadlock(process);
+}
+
+void ScriptEngine::grant(int process, int resource)
+{
+    permits[resource]--;
+    blockedCycles += currentCycle - waitingSince[process];
+    waitingSince[process] = -1;
+    waitingOn[process] = -1;
+
+    int acquisition = pendingAcquisition[process];
+    pendingAcquisition[process] = -1;
+    if (acquisition != -1) {
+        acquisitions[acquisition].completed = true;
+        acquisitions[acquisition].completionCycle = currentCycle;
+    }
+    addHolder(process, resource, acquisition);
+    ready.push_back(process);
+}
+
+void ScriptEngine::addHolder(int process, int resource, int acquisition)
+{
+    held[process].push_back({resource, acquisition});
+    holders[resource].push_back(process);
+}
+
+void ScriptEngine::detectDeadlock(int process)
+{
+    // Quien espera algo que retiene un proceso recién atrapado puede haber quedado sin salida
+    // aunque se bloqueó antes; se revisa igual que al bloquearse
+    std::vector<int> pending{process};
+    std::vector<int> newlyTrapped;
+    while (!pending.empty()) {
+        int next = pending.back();
+        pending.pop_back();
+        if (deadlocked[next]) continue;
+
+        newlyTrapped.clear();
+        searchWaitGraph(next, newlyTrapped);
+        for (int trapped : newlyTrapped) {
+            for (const HeldResource &owned : held[trapped]) {
+                for (int waiter = queueHead[owned.resource]; waiter != -1; waiter = nextWaiter[waiter]) {
+                    if (!deadlocked[waiter]) pending.push_back(waiter);
+                }
+            }
+        }
+    }
+}
+
+void ScriptEngine::searchWaitGraph(int start, std::vector<int> &newlyTrapped)
+{
+    // Búsqueda en profundidad por el grafo de espera desde un proceso bloqueado.
+    // Basta alcanzar un proceso que no espera (corre o está en HOLD) para saber que todavía
+    // puede liberar algo; en el caso común la búsqueda termina en el primer retenedor, y en
+    // general cuesta lo mismo que la cadena de procesos bloqueados anidados que recorre.
+    // Los procesos ya atrapados también se recorren, para contar todo lo que quedó detrás.
+    struct Frame {
+        int process;
+        std::size_t nextHolder;
+    };
+
+    if (++visitStamp == 0) {
+        std::fill(visitMark.begin(), visitMark.end(), 0u);
+        visitStamp = 1;
+    }
+
+    std::vector<Frame> path{{start, 0}};
+    std::vector<int> trapped{start};
+    std::vector<int> cycleProcesses;
+    std::vector<int> cycleResources;
+    visitMark[start] = visitStamp;
+    onPath[start] = 1;
+
+    bool canProgress = false;
+    while (!path.empty()) {
+        Frame &frame = path.back();
+        const std::vector<int> &owners = holders[waitingOn[frame.process]];
+        if (frame.nextHolder == owners.size()) {
+            onPath[frame.process] = 0;
+            path.pop_back();
+            continue;
+        }
+
+        int owner = owners[frame.nextHolder++];
+        if (visitMark[owner] == visitStamp) {
+            // Arista de regreso al camino actual: el ciclo va de `owner` hasta el tope. Si `owner`
+            // ya estaba atrapado, el ciclo se reportó cuando se formó
+            if (onPath[owner] && !deadlocked[owner] && cycleProcesses.empty()) {
+                auto from = std::find_if(path.begin(), path.end(), [owner](const Frame &f) {
+                    return f.process == owner;
+                });
+                for (auto it = from; it != path.end(); ++it) {
+                    cycleProcesses.push_back(it->process);
+                    cycleResources.push_back(waitingOn[it->process]);
+                }
+            }
+            continue;
+        }
+        visitMark[owner] = visitStamp;
+
+        if (waitingOn[owner] == -1) {
+            canProgress = true;
+            break;
+        }
+
+        onPath[owner] = 1;
+        path.push_back({owner, 0});
+        trapped.push_back(owner);
+    }
+
+    for (const Frame &frame : path) {
+        onPath[frame.process] = 0;
+    }
+    if (canProgress) return;
+
+    // Todo lo alcanzable espera a otro proceso alcanzable: nadie podrá liberar nada
+    for (int process : trapped) {
+        if (deadlocked[process]) continue;
+        deadlocked[process] = 1;
+        newlyTrapped.push_back(process);
+    }
+
+    if (!cycleProcesses.empty()) {
+        foundDeadlocks.push_back({currentCycle, cycleProcesses, cycleResources, int(trapped.size())});
+        return;
+    }
+
+    // Sin ciclo nuevo el proceso espera un recurso sin permisos que nadie retiene, o quedó
+    // detrás de procesos atrapados antes
+    const int resource = waitingOn[start];
+    foundStarvations.push_back({currentCycle, start, resource, holders[resource].empty(), int(trapped.size())});
+}
+
+void ScriptEngine::release(int process, int resource)
+{
+    std::vector<HeldResource> &owned = held[process];
+    auto found = std::find_if(owned.rbegin(), owned.rend(), [resource](const HeldResource &h) {
+        return h.resource == resource;
+    });
+    // Liberar algo que no se tiene no hace nada
+    if (found == owned.rend()) return;
+
+    if (found->acquisition != -1) {
+        Action &action = acquisitions[found->acquisition];
+        action.holdCycles = std::max(1, currentCycle - action.completionCycle);
+    }
+    owned.erase(std::next(found).base());
+
+    std::vector<int> &owners = holders[resource];
+    auto owner = std::find(owners.begin(), owners.end(), process);
+    if (owner != owners.end()) {
+        *owner = owners.back();
+        owners.pop_back();
+    }
+    permits[resource]++;
+
+    while (permits[resource] > 0 && queueHead[resource] != -1) {
+        int next = queueHead[resource];
+        queueHead[resource] = nextWaiter[next];
+        if (queueHead[resource] == -1) queueTail[resource] = -1;
+        nextWaiter[next] = -1;
+        grant(next, resource);
+    }
+}
+
+void ScriptEngine::releaseAll(int process)
+{
+    while (!held[process].empty()) {
+        release(process, held[process].back().resource);
+    }
+}
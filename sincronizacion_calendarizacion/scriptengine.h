@@ -0,0 +1,180 @@
+#ifndef SCRIPTENGINE_H
+#define SCRIPTENGINE_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QMap>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <vector>
+#include "syncengine.h"
+#include "timerwheel.h"
+
+enum class ScriptStepKind : std::uint8_t {
+    Acquire,    // Espera hasta obtener un permiso del recurso
+    Hold,       // Retiene lo obtenido durante n ciclos
+    Release     // Libera el recurso y despierta al siguiente en la cola
+};
+
+struct ScriptStep {
+    ScriptStepKind kind;
+    int argument;   // Índice del recurso en ACQUIRE/RELEASE, ciclos en HOLD
+};
+
+// Guiones de todos los procesos en arreglos planos: los pasos del proceso p están en
+// steps[firstStep[p], firstStep[p + 1]). Así un millón de procesos no cuesta un
+// contenedor por proceso.
+struct ScriptProgram {
+    QStringList processNames;
+    QStringList resourceNames;
+    std::vector<int> startCycle;
+    std::vector<int> firstStep;
+    std::vector<ScriptStep> steps;
+
+    int processCount() const { return int(startCycle.size()); }
+};
+
+// Archivo de guiones: una línea por paso, en orden para cada proceso.
+//   PID, START, ciclo      (opcional, ciclo de llegada; 0 por defecto)
+//   PID, ACQUIRE, recurso
+//   PID, HOLD, ciclos
+//   PID, RELEASE, recurso
+// Las líneas de procesos distintos pueden intercalarse.
+ScriptProgram parseScriptFile(const QString &content);
+
+// Interbloqueo detectado: processes[i] espera resources[i], que retiene processes[i + 1]
+// (el último espera un recurso que retiene el primero)
+struct ScriptDeadlock {
+    int cycle;
+    std::vector<int> processes;
+    std::vector<int> resources;
+    int trappedProcesses;   // Procesos alcanzables que ya no pueden avanzar, incluido el ciclo
+};
+
+// Bloqueo permanente sin ciclo nuevo: el proceso espera un recurso de capacidad 0, que nadie
+// retiene, o quedó detrás de procesos atrapados en un hallazgo anterior
+struct ScriptStarvation {
+    int cycle;
+    int process;
+    int resource;           // Recurso que espera
+    bool zeroCapacity;      // true si el recurso no tiene permisos ni retenedores
+    int trappedProcesses;   // Procesos alcanzables que ya no pueden avanzar, incluido este
+};
+
+struct ScriptRunResult {
+    int finalCycle = 0;
+    int finishedProcesses = 0;
+    long long totalBlockedCycles = 0;
+    std::vector<int> blockedProcesses;  // Procesos que terminaron esperando un recurso
+    QVector<Action> acquisitions;       // Un registro por ACQUIRE, con el formato de las acciones
+    std::vector<ScriptDeadlock> deadlocks;
+    std::vector<ScriptStarvation> starvations;
+};
+
+// Ejecuta cada proceso del guion como una corrutina de C++20. Un ACQUIRE sin permisos
+// suspende la corrutina en la cola del recurso y el RELEASE que libera el permiso la
+// reanuda; un HOLD la suspende en la rueda de tiempo. No hay hilos ni recorridos por
+// proceso: cada ciclo solo toca las corrutinas que despiertan en él, y el marco de cada
+// corrutina se crea al llegar el proceso y se libera al terminar.
+// Los recursos se comportan como semáforos con la capacidad indicada (1 = mutex).
+// El motor mantiene un grafo de espera (proceso -> recurso que espera -> procesos que lo
+// retienen) que se actualiza en cada espera y cada concesión; los interbloqueos se buscan
+// solo desde el proceso que acaba de bloquearse y, si quedó atrapado, desde los que esperan
+// lo que retiene. Un bloqueo permanente sin ciclo se reporta aparte, como inanición.
+class ScriptEngine
+{
+public:
+    ScriptEngine(const ScriptProgram &program, const QMap<QString, int> &capacity, bool keepHistory = true);
+    ~ScriptEngine();
+
+    ScriptEngine(const ScriptEngine &) = delete;
+    ScriptEngine &operator=(const ScriptEngine &) = delete;
+
+    bool step();                // Avanza un ciclo; true si ya no queda nada por reanudar
+    ScriptRunResult runToCompletion();
+    int cycle() const { return currentCycle; }
+    const std::vector<ScriptDeadlock> &deadlocks() const { return foundDeadlocks; }
+    const std::vector<ScriptStarvation> &starvations() const { return foundStarvations; }
+
+private:
+    struct ProcessTask {
+        struct promise_type {
+            ProcessTask get_return_object()
+            {
+                return {std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+            std::suspend_always initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { std::terminate(); }
+        };
+        std::coroutine_handle<promise_type> handle;
+    };
+
+    struct AcquireAwaiter {
+        ScriptEngine &engine;
+        int process;
+        int resource;
+        bool await_ready() { return engine.tryAcquire(process, resource); }
+        void await_suspend(std::coroutine_handle<>) { engine.enqueueWaiter(process, resource); }
+        void await_resume() {}
+    };
+
+    struct HoldAwaiter {
+        ScriptEngine &engine;
+        int process;
+        int cycles;
+        bool await_ready() { return cycles <= 0; }
+        void await_suspend(std::coroutine_handle<>) { engine.wakeups.schedule(engine.currentCycle + cycles, process); }
+        void await_resume() {}
+    };
+
+    struct HeldResource {
+        int resource;
+        int acquisition;    // Índice en `acquisitions`, -1 sin historial
+    };
+
+    const ScriptProgram &program;
+    bool keepHistory;
+    std::vector<int> permits;
+    std::vector<int> queueHead;     // Colas de espera intrusivas por recurso
+    std::vector<int> queueTail;
+    std::vector<int> nextWaiter;    // Siguiente proceso en la misma cola
+    std::vector<int> waitingSince;
+    std::vector<int> pendingAcquisition;
+    std::vector<std::vector<HeldResource>> held;
+    std::vector<int> waitingOn;                 // Arista de espera de cada proceso, -1 si no espera
+    std::vector<std::vector<int>> holders;      // Procesos que retienen cada recurso
+    std::vector<char> deadlocked;               // Procesos ya reportados como atrapados
+    std::vector<unsigned> visitMark;
+    std::vector<char> onPath;
+    unsigned visitStamp;
+    std::vector<ScriptDeadlock> foundDeadlocks;
+    std::vector<ScriptStarvation> foundStarvations;
+    std::vector<std::coroutine_handle<>> tasks;
+    std::vector<int> arrivalOrder;  // Procesos ordenados por ciclo de inicio
+    std::size_t nextArrival;
+    TimerWheel<int> wakeups;
+    std::vector<int> ready;
+    QVector<Action> acquisitions;
+    int finishedCount;
+    long long blockedCycles;
+    int currentCycle;
+    bool started;
+
+    ProcessTask runProcess(int process);
+    void resume(int process);
+    bool tryAcquire(int process, int resource);
+    void enqueueWaiter(int process, int resource);
+    void grant(int process, int resource);
+    void release(int process, int resource);
+    void releaseAll(int process);
+    int recordRequest(int process, int resource, bool waiting);
+    void addHolder(int process, int resource, int acquisition);
+    void detectDeadlock(int process);
+    void searchWaitGraph(int start, std::vector<int> &newlyTrapped);
+};
+
+#endif // SCRIPTENGINE_H
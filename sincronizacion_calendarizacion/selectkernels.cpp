@@ -0,0 +1,119 @@
+#include "selectkernels.h"
+#include <algorithm>
+#include <climits>
+
+#if SIM_SIMD_SELECT && (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SELECT_X86 1
+#include <immintrin.h>
+#else
+#define SELECT_X86 0
+#endif
+
+namespace {
+
+// Por debajo de esto el recorrido escalar gana: no alcanza a llenar los registros
+const int SIMD_MIN_COUNT = 16;
+
+using Kernel = int (*)(const int *, int);
+
+int scalarFirstMin(const int *keys, int count)
+{
+    int best = 0;
+    for (int i = 1; i < count; ++i) {
+        if (keys[i] < keys[best]) best = i;
+    }
+    return best;
+}
+
+#if SELECT_X86
+
+// Las dos versiones hacen dos pasadas: el mínimo por carriles y luego la primera posición
+// que lo tiene, así el empate se resuelve igual que en el recorrido escalar
+
+__attribute__((target("avx2")))
+int avx2FirstMin(const int *keys, int count)
+{
+    const int full = count & ~7;
+    __m256i low = _mm256_set1_epi32(INT_MAX);
+    for (int i = 0; i < full; i += 8) {
+        low = _mm256_min_epi32(low, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i)));
+    }
+    __m128i half = _mm_min_epi32(_mm256_castsi256_si128(low), _mm256_extracti128_si256(low, 1));
+    half = _mm_min_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+    half = _mm_min_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+    int minimum = _mm_cvtsi128_si32(half);
+    for (int i = full; i < count; ++i) minimum = std::min(minimum, keys[i]);
+
+    const __m256i target = _mm256_set1_epi32(minimum);
+    for (int i = 0; i < full; i += 8) {
+        __m256i equal = _mm256_cmpeq_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(keys + i)), target);
+        int mask = _mm256_movemask_ps(_mm256_castsi256_ps(equal));
+        if (mask) return i + __builtin_ctz(mask);
+    }
+    for (int i = full; i < count; ++i) {
+        if (keys[i] == minimum) return i;
+    }
+    return 0;
+}
+
+__attribute__((target("sse4.1")))
+int sse41FirstMin(const int *keys, int count)
+{
+    const int full = count & ~3;
+    __m128i low = _mm_set1_epi32(INT_MAX);
+    for (int i = 0; i < full; i += 4) {
+        low = _mm_min_epi32(low, _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i)));
+    }
+    low = _mm_min_epi32(low, _mm_shuffle_epi32(low, _MM_SHUFFLE(1, 0, 3, 2)));
+    low = _mm_min_epi32(low, _mm_shuffle_epi32(low, _MM_SHUFFLE(2, 3, 0, 1)));
+    int minimum = _mm_cvtsi128_si32(low);
+    for (int i = full; i < count; ++i) minimum = std::min(minimum, keys[i]);
+
+    const __m128i target = _mm_set1_epi32(minimum);
+    for (int i = 0; i < full; i += 4) {
+        __m128i equal = _mm_cmpeq_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i)), target);
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(equal));
+        if (mask) return i + __builtin_ctz(mask);
+    }
+    for (int i = full; i < count; ++i) {
+        if (keys[i] == minimum) return i;
+    }
+    return 0;
+}
+
+#endif
+
+struct SelectedKernel {
+    Kernel kernel;
+    const char *name;
+};
+
+SelectedKernel detectKernel()
+{
+#if SELECT_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return {avx2FirstMin, "avx2"};
+    if (__builtin_cpu_supports("sse4.1")) return {sse41FirstMin, "sse4.1"};
+#endif
+    return {scalarFirstMin, "escalar"};
+}
+
+const SelectedKernel &selected()
+{
+    static const SelectedKernel kernel = detectKernel();
+    return kernel;
+}
+
+}
+
+int firstMinIndex(const int *keys, int count)
+{
+    if (count <= 0) return -1;
+    if (count < SIMD_MIN_COUNT) return scalarFirstMin(keys, count);
+    return selected().kernel(keys, count);
+}
+
+const char *selectKernelName()
+{
+    return selected().name;
+}
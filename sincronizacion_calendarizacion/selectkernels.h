@@ -0,0 +1,17 @@
+#ifndef SELECTKERNELS_H
+#define SELECTKERNELS_H
+
+// Con SIM_SIMD_SELECT=0 solo se compila la versión escalar
+#ifndef SIM_SIMD_SELECT
+#define SIM_SIMD_SELECT 1
+#endif
+
+// Posición del primer mínimo de `keys[0..count)`, -1 si está vacío. Es la elección de las
+// políticas ordenadas: menor clave y, en empate, la primera en la cola. En x86 usa AVX2 o
+// SSE4.1 según lo que soporte el procesador al arrancar; en otro caso un recorrido escalar.
+int firstMinIndex(const int *keys, int count);
+
+// Nombre del kernel elegido ("avx2", "sse4.1" o "escalar"), para el registro
+const char *selectKernelName();
+
+#endif // SELECTKERNELS_H
@@ -0,0 +1,118 @@
+#include "siminstrumentation.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QStringList>
+
+void SimProfile::addTime(const char *phase, qint64 nanoseconds)
+{
+    for (Phase &entry : phaseList) {
+        if (entry.name == QLatin1String(phase)) {
+            entry.nanoseconds += nanoseconds;
+            entry.calls++;
+            return;
+        }
+    }
+    Phase entry;
+    entry.name = QString::fromUtf8(phase);
+    entry.nanoseconds = nanoseconds;
+    entry.calls = 1;
+    phaseList.append(entry);
+}
+
+void SimProfile::count(const char *counter, qint64 amount)
+{
+    for (Counter &entry : counterList) {
+        if (entry.name == QLatin1String(counter)) {
+            entry.value += amount;
+            return;
+        }
+    }
+    Counter entry;
+    entry.name = QString::fromUtf8(counter);
+    entry.value = amount;
+    counterList.append(entry);
+}
+
+void SimProfile::addRate(const QString &name, const QString &counter, const QString &phase)
+{
+    rates.append(Rate{name, counter, phase});
+}
+
+void SimProfile::reset()
+{
+    phaseList.clear();
+    counterList.clear();
+}
+
+qint64 SimProfile::counterValue(const QString &name) const
+{
+    for (const Counter &entry : counterList) {
+        if (entry.name == name) return entry.value;
+    }
+    return 0;
+}
+
+double SimProfile::rateValue(const Rate &rate) const
+{
+    for (const Phase &entry : phaseList) {
+        if (entry.name == rate.phase && entry.nanoseconds > 0) {
+            return counterValue(rate.counter) * 1e9 / entry.nanoseconds;
+        }
+    }
+    return 0;
+}
+
+QString SimProfile::toText() const
+{
+    if (!SIM_INSTRUMENTATION) return "Instrumentación desactivada al compilar (SIM_INSTRUMENTATION=0)";
+    if (phaseList.isEmpty() && counterList.isEmpty()) return "Sin mediciones todavía";
+
+    QStringList lines;
+    lines << QString("%1 %2 %3 %4").arg("Fase", -22).arg("Llamadas", 10).arg("Total ms", 12).arg("Promedio us", 13);
+    for (const Phase &entry : phaseList) {
+        lines << QString("%1 %2 %3 %4")
+                     .arg(entry.name, -22)
+                     .arg(entry.calls, 10)
+                     .arg(entry.nanoseconds / 1e6, 12, 'f', 3)
+                     .arg(entry.nanoseconds / 1e3 / entry.calls, 13, 'f', 1);
+    }
+    lines << "";
+    for (const Counter &entry : counterList) {
+        lines << QString("%1 %2").arg(entry.name, -22).arg(entry.value);
+    }
+    for (const Rate &rate : rates) {
+        lines << QString("%1 %2").arg(rate.name, -22).arg(rateValue(rate), 0, 'f', 0);
+    }
+    return lines.join('\n');
+}
+
+QByteArray SimProfile::toJson(const QString &source) const
+{
+    QJsonArray phaseArray;
+    for (const Phase &entry : phaseList) {
+        QJsonObject object;
+        object["nombre"] = entry.name;
+        object["llamadas"] = entry.calls;
+        object["total_ms"] = entry.nanoseconds / 1e6;
+        object["promedio_us"] = entry.nanoseconds / 1e3 / entry.calls;
+        phaseArray.append(object);
+    }
+
+    QJsonObject counterObject;
+    for (const Counter &entry : counterList) {
+        counterObject[entry.name] = entry.value;
+    }
+    QJsonObject rateObject;
+    for (const Rate &rate : rates) {
+        rateObject[rate.name] = rateValue(rate);
+    }
+
+    QJsonObject root;
+    root["origen"] = source;
+    root["instrumentacion"] = bool(SIM_INSTRUMENTATION);
+    root["fases"] = phaseArray;
+    root["contadores"] = counterObject;
+    root["tasas"] = rateObject;
+    return QJsonDocument(root).toJson(QJsonDocument::Indented);
+}
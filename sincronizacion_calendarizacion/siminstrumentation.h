@@ -0,0 +1,89 @@
+#ifndef SIMINSTRUMENTATION_H
+#define SIMINSTRUMENTATION_H
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QString>
+#include <QVector>
+
+// Con SIM_INSTRUMENTATION=0 las macros SIM_* no generan código: ni temporizadores ni contadores
+#ifndef SIM_INSTRUMENTATION
+#define SIM_INSTRUMENTATION 1
+#endif
+
+// Tiempo de pared y contadores por fase de una ventana (lectura, parseo, motor, métricas,
+// escena). Se usa desde el hilo de la interfaz; las fases se guardan en orden de aparición
+// y una fase anidada en otra también suma en la de afuera.
+class SimProfile
+{
+public:
+    struct Phase {
+        QString name;
+        qint64 nanoseconds = 0;
+        qint64 calls = 0;
+    };
+
+    struct Counter {
+        QString name;
+        qint64 value = 0;
+    };
+
+    // Tasa derivada: contador por segundo de la fase indicada (por ejemplo decisiones del motor)
+    struct Rate {
+        QString name;
+        QString counter;
+        QString phase;
+    };
+
+    void addTime(const char *phase, qint64 nanoseconds);
+    void count(const char *counter, qint64 amount = 1);
+    void addRate(const QString &name, const QString &counter, const QString &phase);
+    void reset();
+
+    const QVector<Phase> &phases() const { return phaseList; }
+    const QVector<Counter> &counters() const { return counterList; }
+    qint64 counterValue(const QString &name) const;
+    double rateValue(const Rate &rate) const;
+
+    QString toText() const;                         // Tabla legible para el panel de diagnóstico
+    QByteArray toJson(const QString &source) const; // Mismo contenido para guardar o comparar
+
+private:
+    QVector<Phase> phaseList;
+    QVector<Counter> counterList;
+    QVector<Rate> rates;
+};
+
+// Suma al perfil el tiempo entre su construcción y su destrucción
+class ScopedPhase
+{
+public:
+    ScopedPhase(SimProfile &profile, const char *phase) : profile(profile), phase(phase) { timer.start(); }
+    ~ScopedPhase() { profile.addTime(phase, timer.nsecsElapsed()); }
+
+    ScopedPhase(const ScopedPhase &) = delete;
+    ScopedPhase &operator=(const ScopedPhase &) = delete;
+
+private:
+    SimProfile &profile;
+    const char *phase;
+    QElapsedTimer timer;
+};
+
+#define SIM_CONCAT_IMPL(a, b) a##b
+#define SIM_CONCAT(a, b) SIM_CONCAT_IMPL(a, b)
+
+#if SIM_INSTRUMENTATION
+#define SIM_PHASE(profile, phase) ScopedPhase SIM_CONCAT(simPhase, __LINE__)(profile, phase)
+#define SIM_TIME(profile, phase, nanoseconds) (profile).addTime(phase, nanoseconds)    // Medido en otro hilo
+#define SIM_COUNT(profile, counter, amount) (profile).count(counter, amount)
+#define SIM_TALLY(variable) (++(variable))     // Contador local de un motor, sin perfil
+#else
+// sizeof nombra el argumento sin evaluarlo: no genera código y no deja variables sin usar
+#define SIM_PHASE(profile, phase) ((void)0)
+#define SIM_TIME(profile, phase, nanoseconds) ((void)sizeof(nanoseconds))
+#define SIM_COUNT(profile, counter, amount) ((void)sizeof(amount))
+#define SIM_TALLY(variable) ((void)sizeof(variable))
+#endif
+
+#endif // SIMINSTRUMENTATION_H
@@ -0,0 +1,102 @@
+#include "simlogger.h"
+#include <QDebug>
+#include <QStringList>
+
+SimLogger::SimLogger(std::size_t capacity)
+{
+    // Capacidad potencia de dos para indexar con una máscara
+    std::size_t size = 2;
+    while (size < capacity) size <<= 1;
+
+    slots.reset(new Slot[size]);
+    mask = size - 1;
+    for (std::size_t i = 0; i < size; ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool SimLogger::log(LogLevel level, const QString &message)
+{
+    if (!enabled(level)) return false;
+
+    // Cada casilla lleva un número de secuencia: igual a la posición cuando está libre,
+    // posición + 1 cuando ya tiene un mensaje listo para el consumidor
+    std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    while (true) {
+        Slot &slot = slots[pos & mask];
+        std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t diff = std::ptrdiff_t(sequence) - std::ptrdiff_t(pos);
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.level = level;
+                slot.message = message;
+                slot.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+std::size_t SimLogger::drain(std::vector<LogEntry> &out)
+{
+    std::size_t taken = 0;
+    while (true) {
+        Slot &slot = slots[dequeuePos & mask];
+        if (slot.sequence.load(std::memory_order_acquire) != dequeuePos + 1) break;
+
+        out.push_back({slot.level, std::move(slot.message)});
+        slot.message = QString();
+        slot.sequence.store(dequeuePos + mask + 1, std::memory_order_release);
+        ++dequeuePos;
+        ++taken;
+    }
+    return taken;
+}
+
+LogFlusher::LogFlusher(SimLogger &logger, QTextEdit *view, int intervalMs, QObject *parent) :
+    QObject(parent),
+    logger(logger),
+    view(view)
+{
+    connect(&timer, &QTimer::timeout, this, &LogFlusher::flush);
+    timer.start(intervalMs);
+}
+
+void LogFlusher::flush()
+{
+    batch.clear();
+    logger.drain(batch);
+    std::size_t dropped = logger.takeDropped();
+    if (batch.empty() && dropped == 0) return;
+
+    QStringList lines;
+    lines.reserve(int(batch.size()) + 1);
+    for (LogEntry &entry : batch) {
+        if (entry.level == LogLevel::Error && view) {
+            qDebug().noquote() << entry.message;
+        }
+        lines.append(std::move(entry.message));
+    }
+    if (dropped > 0) {
+        lines.append(QString("(%1 mensajes descartados: búfer de registro lleno)").arg(dropped));
+    }
+
+    if (view) {
+        view->append(lines.join('\n'));
+    } else {
+        qDebug().noquote() << lines.join('\n');
+    }
+}
+
+void LogFlusher::discardPending()
+{
+    batch.clear();
+    logger.drain(batch);
+    logger.takeDropped();
+    batch.clear();
+}
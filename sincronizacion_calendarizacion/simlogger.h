@@ -0,0 +1,80 @@
+#ifndef SIMLOGGER_H
+#define SIMLOGGER_H
+
+#include <QObject>
+#include <QString>
+#include <QTextEdit>
+#include <QTimer>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+enum class LogLevel {
+    Debug,      // Un mensaje por evento de la simulación
+    Info,       // Inicio, fin y resúmenes de cada corrida
+    Error,      // Errores de archivos o de configuración
+    Off         // Sin registro (corridas sin interfaz)
+};
+
+struct LogEntry {
+    LogLevel level;
+    QString message;
+};
+
+// Registro con niveles sobre un búfer circular sin candados.
+// Cualquier hilo puede escribir con log(); un solo consumidor (el hilo de la interfaz)
+// vacía el búfer con drain(). Si el búfer se llena, los mensajes nuevos se descartan y
+// se cuentan en lugar de bloquear la simulación.
+class SimLogger
+{
+public:
+    explicit SimLogger(std::size_t capacity = 1 << 16);
+
+    void setLevel(LogLevel level) { threshold.store(int(level), std::memory_order_relaxed); }
+    LogLevel level() const { return LogLevel(threshold.load(std::memory_order_relaxed)); }
+
+    // Permite saltarse el formateo del mensaje cuando el nivel está filtrado
+    bool enabled(LogLevel level) const
+    {
+        int current = threshold.load(std::memory_order_relaxed);
+        return current != int(LogLevel::Off) && int(level) >= current;
+    }
+
+    bool log(LogLevel level, const QString &message);
+    std::size_t drain(std::vector<LogEntry> &out);
+    std::size_t takeDropped() { return dropped.exchange(0, std::memory_order_relaxed); }
+
+private:
+    struct Slot {
+        std::atomic<std::size_t> sequence;
+        LogLevel level;
+        QString message;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    std::size_t mask;
+    std::atomic<std::size_t> enqueuePos{0};
+    std::size_t dequeuePos = 0;
+    std::atomic<std::size_t> dropped{0};
+    std::atomic<int> threshold{int(LogLevel::Info)};
+};
+
+// Vacía periódicamente un SimLogger hacia un QTextEdit en un solo bloque por lote.
+// Sin vista, el lote se escribe de una vez en la salida de depuración.
+class LogFlusher : public QObject
+{
+public:
+    LogFlusher(SimLogger &logger, QTextEdit *view, int intervalMs = 200, QObject *parent = nullptr);
+
+    void flush();
+    void discardPending();
+
+private:
+    SimLogger &logger;
+    QTextEdit *view;
+    QTimer timer;
+    std::vector<LogEntry> batch;
+};
+
+#endif // SIMLOGGER_H
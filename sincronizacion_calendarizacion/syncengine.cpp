@@ -0,0 +1,618 @@
+#include "syncengine.h"
+#include "parallel.h"
+#include <QPair>
+#include <QStringList>
+#include <algorithm>
+#include <queue>
+#include <set>
+
+SyncEngine::SyncEngine(const SyncConfig &config, bool keepHistory)
+    : config(config), keepHistory(keepHistory)
+{
+    nextArrival = 0;
+    grantedCount = 0;
+    currentCycle = 0;
+    started = false;
+}
+
+void SyncEngine::load(const QVector<Action> &source)
+{
+    actions = source;
+    resourceInUse.clear();
+    semaphoreCounts.clear();
+    resourceIndex.clear();
+    // Soltar el vector antes que la arena: lo que repartió la corrida anterior se va junto
+    std::pmr::vector<std::pmr::deque<Action*>>(&arena).swap(waitingQueues);
+    arena.release();
+    rwLocks.clear();
+    releaseWheel.clear();
+    cycleEvents.clear();
+    grantedThisCycle.clear();
+
+    for (Action &a : actions) {
+        a.completed = false;
+        a.completionCycle = -1;
+        a.waitingSince = -1;
+
+        if (!resourceInUse.contains(a.resource)) {
+            resourceInUse[a.resource] = false;
+            rwLocks[a.resource] = RwLockState();
+            semaphoreCounts[a.resource] = config.capacity.value(a.resource, 1);
+        }
+    }
+
+    // Las colas quedan en el orden de los nombres, el mismo en que se atienden
+    for (auto it = resourceInUse.begin(); it != resourceInUse.end(); ++it) {
+        resourceIndex.insert(it.key(), int(waitingQueues.size()));
+        waitingQueues.emplace_back();
+    }
+
+    // Estable: las acciones del mismo proceso en el mismo ciclo llegan en el orden del archivo
+    std::stable_sort(actions.begin(), actions.end(), [](const Action &a, const Action &b) {
+        if (a.cycle == b.cycle) return a.PID < b.PID;
+        return a.cycle < b.cycle;
+    });
+
+    nextArrival = 0;
+    grantedCount = 0;
+    currentCycle = 0;
+    started = false;
+}
+
+WakeupPolicy SyncEngine::wakeupPolicyFor(const QString &resource) const
+{
+    return config.resourcePolicies.value(resource, config.defaultWakeup);
+}
+
+bool SyncEngine::tryAccessResource(Action* action, bool fromQueue)
+{
+    if (config.mode == SyncMode::ReaderWriter) {
+        RwLockState &lock = rwLocks[action->resource];
+        bool isWrite = (action->action == "WRITE");
+
+        // Las llegadas nuevas respetan la política; la cola ya eligió su candidato
+        if (!fromQueue) {
+            bool queueEmpty = waitingQueue(action->resource).empty();
+            if (config.rwPolicy == RwPolicy::Fair && !queueEmpty) return false;
+            if (config.rwPolicy == RwPolicy::WriterPreferring && !isWrite && lock.waitingWriters > 0) return false;
+        }
+
+        if (isWrite) {
+            if (lock.writerActive || lock.activeReaders > 0) return false;
+            lock.writerActive = true;
+        } else {
+            if (lock.writerActive) return false;
+            lock.activeReaders++;
+        }
+        return true;
+    } else if (config.mode == SyncMode::Semaphore) {
+        int &count = semaphoreCounts[action->resource];
+        if (count > 0) {
+            count--;
+            return true;
+        }
+    } else {
+        if (!resourceInUse[action->resource]) {
+            resourceInUse[action->resource] = true;
+            return true;
+        }
+    }
+    return false;
+}
+
+void SyncEngine::releaseResource(const Action &action)
+{
+    const QString &resource = action.resource;
+    if (config.mode == SyncMode::ReaderWriter) {
+        RwLockState &lock = rwLocks[resource];
+        if (action.action == "WRITE") {
+            lock.writerActive = false;
+        } else if (lock.activeReaders > 0) {
+            lock.activeReaders--;
+        }
+    } else if (config.mode == SyncMode::Semaphore) {
+        semaphoreCounts[resource]++;
+    } else {
+        resourceInUse[resource] = false;
+    }
+}
+
+std::pmr::deque<Action*> &SyncEngine::waitingQueue(const QString &resource)
+{
+    return waitingQueues[resourceIndex.value(resource)];
+}
+
+bool SyncEngine::waitingQueuesEmpty() const
+{
+    for (const auto &queue : waitingQueues) {
+        if (!queue.empty()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+QVector<int> SyncEngine::waitingActions(const QString &resource) const
+{
+    QVector<int> waiting;
+    int index = resourceIndex.value(resource, -1);
+    if (index == -1) return waiting;
+    for (const Action *action : waitingQueues[index]) {
+        waiting.append(int(action - actions.data()));
+    }
+    return waiting;
+}
+
+void SyncEngine::recordEvent(Action* action, SyncEventKind kind)
+{
+    cycleEvents.append({currentCycle, int(action - actions.data()), kind});
+}
+
+void SyncEngine::markGranted(Action* action)
+{
+    action->completed = true;
+    action->completionCycle = currentCycle;
+    grantedCount++;
+    grantedThisCycle.append(action);
+
+    // La liberación queda programada en la rueda según la duración de la acción
+    releaseWheel.schedule(currentCycle + action->holdCycles, action);
+}
+
+void SyncEngine::grantFromQueue(Action* action)
+{
+    markGranted(action);
+    if (config.mode == SyncMode::ReaderWriter && action->action == "WRITE") {
+        rwLocks[action->resource].waitingWriters--;
+    }
+    recordEvent(action, SyncEventKind::AccessedFromQueue);
+}
+
+void SyncEngine::processReaderWriterQueue(const QString &resource, std::pmr::deque<Action*> &queue)
+{
+    RwLockState &lock = rwLocks[resource];
+
+    if (config.rwPolicy == RwPolicy::Fair) {
+        // FIFO estricto: la cabeza entra y arrastra a los lectores consecutivos
+        while (!queue.empty() && tryAccessResource(queue.front(), true)) {
+            grantFromQueue(queue.front());
+            queue.pop_front();
+        }
+        return;
+    }
+
+    bool writersFirst = (config.rwPolicy == RwPolicy::WriterPreferring && lock.waitingWriters > 0);
+
+    if (!writersFirst && !lock.writerActive) {
+        // Todos los lectores en espera comparten el recurso en este ciclo
+        for (auto it = queue.begin(); it != queue.end();) {
+            if ((*it)->action != "WRITE" && tryAccessResource(*it, true)) {
+                grantFromQueue(*it);
+                it = queue.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    // Un escritor solo entra con el recurso libre y, si se prefieren lectores, sin lectores en espera
+    bool readersWaiting = std::any_of(queue.begin(), queue.end(), [](const Action *a) {
+        return a->action != "WRITE";
+    });
+    if (config.rwPolicy == RwPolicy::ReaderPreferring && readersWaiting) return;
+
+    auto writer = std::find_if(queue.begin(), queue.end(), [](const Action *a) {
+        return a->action == "WRITE";
+    });
+    if (writer != queue.end() && tryAccessResource(*writer, true)) {
+        grantFromQueue(*writer);
+        queue.erase(writer);
+    }
+}
+
+void SyncEngine::processWaitingActions()
+{
+    for (auto it = resourceIndex.begin(); it != resourceIndex.end(); ++it) {
+        std::pmr::deque<Action*>& queue = waitingQueues[it.value()];
+        if (queue.empty()) continue;
+
+        if (config.mode == SyncMode::ReaderWriter) {
+            processReaderWriterQueue(it.key(), queue);
+            continue;
+        }
+
+        WakeupPolicy policy = wakeupPolicyFor(it.key());
+
+        // Con WakeAll se reparten todos los permisos libres en este mismo ciclo
+        while (!queue.empty()) {
+            Action* action = queue.front();
+            if (!tryAccessResource(action, true)) break;
+
+            grantFromQueue(action);
+            queue.pop_front();
+
+            if (policy == WakeupPolicy::WakeOne) break;
+        }
+    }
+}
+
+bool SyncEngine::step()
+{
+    if (started) currentCycle++;
+    started = true;
+
+    grantedThisCycle.clear();
+    cycleEvents.clear();
+
+    // Liberar recursos cuya retención vence en este ciclo
+    dueReleases.clear();
+    releaseWheel.takeDue(currentCycle, dueReleases);
+    for (Action *action : dueReleases) {
+        releaseResource(*action);
+    }
+
+    processWaitingActions();
+
+    // Procesar acciones del ciclo actual (las acciones están ordenadas por ciclo)
+    while (nextArrival < actions.size() && actions[nextArrival].cycle < currentCycle) {
+        nextArrival++;
+    }
+
+    while (nextArrival < actions.size() && actions[nextArrival].cycle == currentCycle) {
+        Action* action = &actions[nextArrival++];
+        if (tryAccessResource(action)) {
+            markGranted(action);
+            recordEvent(action, SyncEventKind::Accessed);
+        } else {
+            waitingQueue(action->resource).push_back(action);
+            action->waitingSince = currentCycle;
+            if (config.mode == SyncMode::ReaderWriter && action->action == "WRITE") {
+                rwLocks[action->resource].waitingWriters++;
+            }
+            recordEvent(action, SyncEventKind::Waiting);
+        }
+    }
+
+    // La corrida termina cuando se liberó la última retención; sin liberaciones pendientes ni
+    // concesiones, las esperas que queden ya no pueden avanzar
+    bool allProcessed = (nextArrival >= actions.size());
+    return allProcessed && releaseWheel.empty() && grantedThisCycle.isEmpty();
+}
+
+SyncRunResult SyncEngine::runToCompletion()
+{
+    SyncRunResult result;
+    while (true) {
+        bool finished = step();
+        if (keepHistory) result.events += cycleEvents;
+        if (finished) break;
+    }
+
+    result.actions = actions;
+    result.finalCycle = currentCycle;
+    result.allCompleted = allCompleted();
+    return result;
+}
+
+SimulationSummary SyncEngine::summarize(const QVector<Action> &results, int finalCycle)
+{
+    SimulationSummary summary;
+    summary.totalCycles = finalCycle + 1;
+    summary.grantedActions = 0;
+    summary.pendingActions = 0;
+
+    int waitedActions = 0;
+    int totalWait = 0;
+    // Intervalos de retención de las lecturas por recurso: +1 al obtenerlo, -1 al soltarlo
+    QMap<QString, QVector<QPair<int, int>>> readBounds;
+    for (const Action &action : results) {
+        if (action.completed) {
+            summary.grantedActions++;
+            if (action.action == "READ") {
+                readBounds[action.resource].append(qMakePair(action.completionCycle, 1));
+                readBounds[action.resource].append(qMakePair(action.completionCycle + action.holdCycles, -1));
+            }
+            if (action.waitingSince != -1) {
+                totalWait += action.completionCycle - action.waitingSince;
+                waitedActions++;
+            }
+        } else {
+            summary.pendingActions++;
+        }
+    }
+
+    summary.throughput = double(summary.grantedActions) / summary.totalCycles;
+    summary.averageWait = waitedActions > 0 ? double(totalWait) / waitedActions : 0.0;
+
+    // Barrido: en el mismo ciclo las liberaciones van antes que los accesos (intervalos semiabiertos)
+    summary.peakConcurrentReaders = 0;
+    for (auto it = readBounds.begin(); it != readBounds.end(); ++it) {
+        QVector<QPair<int, int>> &bounds = it.value();
+        std::sort(bounds.begin(), bounds.end());
+        int readers = 0;
+        for (const auto &bound : bounds) {
+            readers += bound.second;
+            summary.peakConcurrentReaders = std::max(summary.peakConcurrentReaders, readers);
+        }
+    }
+    return summary;
+}
+
+QVector<Action> parseActions(const QString &content)
+{
+    QVector<Action> actions;
+    QStringList lines = content.split('\n', Qt::SkipEmptyParts);
+
+    for (const QString &line : lines) {
+        QStringList parts = line.split(',', Qt::SkipEmptyParts);
+        // Formato: PID, ACCION, RECURSO, CICLO[, DURACION]
+        if (parts.size() == 4 || parts.size() == 5) {
+            Action a;
+            a.PID = parts[0].trimmed();
+            a.action = parts[1].trimmed().toUpper();
+            a.resource = parts[2].trimmed();
+            a.cycle = parts[3].trimmed().toInt();
+            a.holdCycles = parts.size() == 5 ? std::max(1, parts[4].trimmed().toInt()) : 1;
+            a.completed = false;
+            a.completionCycle = -1;
+            a.waitingSince = -1;
+            a.realWaitCycles = -1;
+            actions.append(a);
+        }
+    }
+    return actions;
+}
+
+int parseResources(const QString &content, QMap<QString, int> &capacity, QMap<QString, WakeupPolicy> *policies)
+{
+    int parsed = 0;
+    QStringList lines = content.split('\n', Qt::SkipEmptyParts);
+    for (const QString &line : lines) {
+        QStringList parts = line.split(',', Qt::SkipEmptyParts);
+        if (parts.size() == 2 || parts.size() == 3) {
+            QString resourceName = parts[0].trimmed();
+            int count = parts[1].trimmed().toInt();
+            capacity[resourceName] = count;
+            parsed++;
+
+            if (parts.size() == 3 && policies) {
+                QString policy = parts[2].trimmed().toUpper();
+                if (policy == "ALL" || policy == "BATCH") {
+                    (*policies)[resourceName] = WakeupPolicy::WakeAll;
+                } else if (policy == "ONE") {
+                    (*policies)[resourceName] = WakeupPolicy::WakeOne;
+                }
+            }
+        }
+    }
+    return parsed;
+}
+
+namespace {
+
+struct Interval {
+    int start;
+    int end;
+    int action;
+};
+
+// Reparte intervalos en carriles: cada uno va al carril libre de menor índice
+QVector<Timeline> assignLanes(QVector<Interval> intervals)
+{
+    std::sort(intervals.begin(), intervals.end(), [](const Interval &a, const Interval &b) {
+        if (a.start != b.start) return a.start < b.start;
+        return a.action < b.action;
+    });
+
+    QVector<Timeline> lanes;
+    std::set<int> freeLanes;
+    using Busy = std::pair<int, int>;   // (fin, carril)
+    std::priority_queue<Busy, std::vector<Busy>, std::greater<Busy>> busy;
+    for (const Interval &interval : intervals) {
+        while (!busy.empty() && busy.top().first <= interval.start) {
+            freeLanes.insert(busy.top().second);
+            busy.pop();
+        }
+        int lane;
+        if (freeLanes.empty()) {
+            lane = lanes.size();
+            lanes.append(Timeline());
+        } else {
+            lane = *freeLanes.begin();
+            freeLanes.erase(freeLanes.begin());
+        }
+        lanes[lane].append(interval.action, interval.start, interval.end - interval.start);
+        busy.push({interval.end, lane});
+    }
+    return lanes;
+}
+
+}
+
+SyncTimeline buildSyncTimeline(const QVector<Action> &actions, int finalCycle)
+{
+    QVector<Interval> holding;
+    QVector<Interval> waiting;
+    for (int i = 0; i < actions.size(); ++i) {
+        const Action &action = actions[i];
+        if (action.completionCycle != -1) {
+            holding.append({action.completionCycle, action.completionCycle + action.holdCycles, i});
+        }
+        if (action.waitingSince != -1) {
+            int waitEnd = action.completed ? action.completionCycle : finalCycle + 1;
+            if (waitEnd > action.waitingSince) waiting.append({action.waitingSince, waitEnd, i});
+        }
+    }
+
+    SyncTimeline timeline;
+    timeline.holding = assignLanes(holding);
+    timeline.waiting = assignLanes(waiting);
+    timeline.finalCycle = finalCycle;
+    return timeline;
+}
+
+SyncReplay::SyncReplay(const SyncTimeline &timeline)
+    : holdingLanes(timeline.holding.size()),
+      slotCount(timeline.holding.size() + timeline.waiting.size())
+{
+    auto collect = [this](const QVector<Timeline> &lanes, int firstSlot) {
+        for (int lane = 0; lane < lanes.size(); ++lane) {
+            lanes[lane].forEach([&](const Timeline::Segment &segment) {
+                changes.append({segment.start, firstSlot + lane, segment.owner});
+                changes.append({segment.end(), firstSlot + lane, -1});
+            });
+        }
+    };
+    collect(timeline.holding, 0);
+    collect(timeline.waiting, holdingLanes);
+
+    // En un mismo ciclo se liberan los carriles antes de ocuparlos de nuevo
+    std::sort(changes.begin(), changes.end(), [](const Change &a, const Change &b) {
+        if (a.cycle != b.cycle) return a.cycle < b.cycle;
+        return (a.action != -1) < (b.action != -1);
+    });
+
+    // Una foto al entrar en cada ventana de KEYFRAME_STRIDE ciclos que tiene cambios; las
+    // ventanas sin cambios se resuelven con la foto anterior
+    // Los carriles ocupados se llevan en una lista sin orden con la posición de cada uno, así
+    // que aplicar un cambio cuesta O(1) y una foto solo recorre lo ocupado
+    std::vector<int> slotAction(slotCount, -1);
+    std::vector<int> position(slotCount, -1);
+    std::vector<int> occupiedSlots;
+    keyframes.append({0, 0, {}});
+    int nextKeyframe = KEYFRAME_STRIDE;
+    for (int i = 0; i < changes.size(); ++i) {
+        const Change &change = changes[i];
+        if (change.cycle >= nextKeyframe) {
+            Keyframe keyframe{change.cycle - change.cycle % KEYFRAME_STRIDE, i, {}};
+            std::vector<int> sorted = occupiedSlots;
+            std::sort(sorted.begin(), sorted.end());
+            keyframe.occupied.reserve(int(sorted.size()));
+            for (int slot : sorted) {
+                keyframe.occupied.append(qMakePair(slot, slotAction[slot]));
+            }
+            nextKeyframe = keyframe.cycle + KEYFRAME_STRIDE;
+            keyframes.append(std::move(keyframe));
+        }
+
+        slotAction[change.slot] = change.action;
+        if (change.action != -1 && position[change.slot] == -1) {
+            position[change.slot] = int(occupiedSlots.size());
+            occupiedSlots.push_back(change.slot);
+        } else if (change.action == -1 && position[change.slot] != -1) {
+            int moved = occupiedSlots.back();
+            occupiedSlots[position[change.slot]] = moved;
+            position[moved] = position[change.slot];
+            occupiedSlots.pop_back();
+            position[change.slot] = -1;
+        }
+    }
+}
+
+SyncColumn SyncReplay::stateAt(int cycle) const
+{
+    if (keyframes.isEmpty()) return SyncColumn();
+
+    // Última foto tomada en o antes de `cycle`; faltan a lo sumo los cambios de su ventana
+    auto after = std::partition_point(keyframes.begin() + 1, keyframes.end(), [&](const Keyframe &keyframe) {
+        return keyframe.cycle <= cycle;
+    });
+    const Keyframe &keyframe = *(after - 1);
+
+    QMap<int, int> occupied;    // Carril -> acción
+    for (const auto &entry : keyframe.occupied) {
+        occupied.insert(entry.first, entry.second);
+    }
+    for (int i = keyframe.change; i < changes.size() && changes[i].cycle <= cycle; ++i) {
+        if (changes[i].action == -1) {
+            occupied.remove(changes[i].slot);
+        } else {
+            occupied.insert(changes[i].slot, changes[i].action);
+        }
+    }
+
+    SyncColumn column;
+    for (auto it = occupied.cbegin(); it != occupied.cend(); ++it) {
+        if (it.key() < holdingLanes) {
+            column.holding.append(it.value());
+        } else {
+            column.waiting.append(it.value());
+        }
+    }
+    return column;
+}
+
+SyncRunResult runShardedSimulation(const SyncConfig &config, const QVector<Action> &actions, int threads)
+{
+    // Mismo orden (ciclo, PID) que load(); cada fragmento recuerda dónde van sus acciones
+    QVector<Action> ordered = actions;
+    std::stable_sort(ordered.begin(), ordered.end(), [](const Action &a, const Action &b) {
+        if (a.cycle == b.cycle) return a.PID < b.PID;
+        return a.cycle < b.cycle;
+    });
+
+    // Un fragmento por recurso
+    QMap<QString, int> shardIndex;
+    QVector<QVector<Action>> shardActions;
+    QVector<QVector<int>> shardPositions;
+    for (int i = 0; i < ordered.size(); ++i) {
+        auto found = shardIndex.find(ordered[i].resource);
+        if (found == shardIndex.end()) {
+            found = shardIndex.insert(ordered[i].resource, shardActions.size());
+            shardActions.append(QVector<Action>());
+            shardPositions.append(QVector<int>());
+        }
+        shardActions[found.value()].append(ordered[i]);
+        shardPositions[found.value()].append(i);
+    }
+
+    QVector<SyncRunResult> shardResults(shardActions.size());
+    parallelFor(shardActions.size(), [&](int shard) {
+        SyncEngine engine(config, false);
+        engine.load(shardActions[shard]);
+        shardResults[shard] = engine.runToCompletion();
+        shardResults[shard].events.clear();
+    }, threads);
+
+    // Mezclar: cada acción vuelve a su posición de la corrida serial
+    SyncRunResult merged;
+    merged.actions = ordered;
+    merged.allCompleted = true;
+    for (int shard = 0; shard < shardResults.size(); ++shard) {
+        const SyncRunResult &result = shardResults[shard];
+        for (int i = 0; i < result.actions.size(); ++i) {
+            merged.actions[shardPositions[shard][i]] = result.actions[i];
+        }
+        merged.finalCycle = std::max(merged.finalCycle, result.finalCycle);
+        merged.allCompleted = merged.allCompleted && result.allCompleted;
+    }
+
+    // Flujo de eventos reconstruido desde los tiempos de cada acción
+    for (int i = 0; i < merged.actions.size(); ++i) {
+        const Action &action = merged.actions[i];
+        if (action.waitingSince != -1) {
+            merged.events.append({action.waitingSince, i, SyncEventKind::Waiting});
+            if (action.completed) {
+                merged.events.append({action.completionCycle, i, SyncEventKind::AccessedFromQueue});
+            }
+        } else if (action.completed) {
+            merged.events.append({action.completionCycle, i, SyncEventKind::Accessed});
+        }
+    }
+    // Dentro de un ciclo step() atiende primero las colas, por nombre de recurso y en orden de
+    // entrada (ciclo de espera, posición), y luego las llegadas en orden de posición
+    std::sort(merged.events.begin(), merged.events.end(), [&](const SyncEvent &a, const SyncEvent &b) {
+        if (a.cycle != b.cycle) return a.cycle < b.cycle;
+        bool aQueued = (a.kind == SyncEventKind::AccessedFromQueue);
+        bool bQueued = (b.kind == SyncEventKind::AccessedFromQueue);
+        if (aQueued != bQueued) return aQueued;
+        if (aQueued) {
+            const Action &left = merged.actions[a.action];
+            const Action &right = merged.actions[b.action];
+            if (left.resource != right.resource) return left.resource < right.resource;
+            if (left.waitingSince != right.waitingSince) return left.waitingSince < right.waitingSince;
+        }
+        return a.action < b.action;
+    });
+    return merged;
+}
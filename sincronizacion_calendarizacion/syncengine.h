@@ -0,0 +1,213 @@
+#ifndef SYNCENGINE_H
+#define SYNCENGINE_H
+
+#include <QString>
+#include <QVector>
+#include <QMap>
+#include <deque>
+#include <memory_resource>
+#include <vector>
+#include "timerwheel.h"
+#include "timeline.h"
+
+// Política de despertar de la cola de espera de un recurso
+enum class WakeupPolicy {
+    WakeOne,    // Solo la cabeza de la cola por ciclo
+    WakeAll     // Todos los permisos disponibles en el mismo ciclo
+};
+
+// Política de un candado lector-escritor
+enum class RwPolicy {
+    ReaderPreferring,   // Los lectores entran mientras no haya escritor activo
+    WriterPreferring,   // Un escritor en espera bloquea a los lectores nuevos
+    Fair                // Orden de llegada; lectores consecutivos comparten
+};
+
+enum class SyncMode {
+    Mutex,
+    Semaphore,
+    ReaderWriter
+};
+
+struct Action {
+    QString PID;
+    QString action;
+    QString resource;
+    int cycle;
+    int holdCycles;     // Ciclos que se retiene el recurso tras obtenerlo
+    bool completed;
+    int completionCycle;
+    int waitingSince;
+    double realWaitCycles;  // Espera medida con hilos reales, -1 si no se ha ejecutado
+};
+
+// Estado de un recurso en modo lector-escritor
+struct RwLockState {
+    int activeReaders = 0;
+    bool writerActive = false;
+    int waitingWriters = 0;
+};
+
+// Configuración completa de una corrida; el motor no depende de la ventana
+struct SyncConfig {
+    SyncMode mode = SyncMode::Mutex;
+    RwPolicy rwPolicy = RwPolicy::ReaderPreferring;
+    WakeupPolicy defaultWakeup = WakeupPolicy::WakeOne;
+    QMap<QString, WakeupPolicy> resourcePolicies;
+    QMap<QString, int> capacity;    // Permisos por recurso en modo semáforo
+};
+
+enum class SyncEventKind {
+    Accessed,           // Obtuvo el recurso al llegar
+    AccessedFromQueue,  // Obtuvo el recurso desde la cola de espera
+    Waiting             // Entró a la cola de espera
+};
+
+// Evento de la simulación; `action` es el índice en las acciones del resultado
+struct SyncEvent {
+    int cycle;
+    int action;
+    SyncEventKind kind;
+};
+
+// Resumen de una corrida completa, usado para comparar políticas
+struct SimulationSummary {
+    int totalCycles;
+    int grantedActions;
+    int pendingActions;
+    double throughput;      // Accesos concedidos por ciclo
+    double averageWait;     // Ciclos de espera promedio de las acciones que esperaron
+    int peakConcurrentReaders;  // Máximo de lecturas concedidas a la vez sobre un recurso
+};
+
+// Resultado de una corrida completa: acciones ordenadas por ciclo con sus tiempos
+struct SyncRunResult {
+    QVector<Action> actions;
+    QVector<SyncEvent> events;
+    int finalCycle = 0;
+    bool allCompleted = false;
+};
+
+// Motor de simulación de sincronización por ciclos.
+// Se carga con las acciones, se avanza con step() un ciclo a la vez y expone los
+// eventos de cada ciclo para que la ventana los registre o los dibuje.
+// Las colas de espera de una corrida salen de una arena que load() libera de una vez.
+class SyncEngine
+{
+public:
+    // Con keepHistory, runToCompletion() también junta los eventos de todos los ciclos
+    explicit SyncEngine(const SyncConfig &config, bool keepHistory = true);
+
+    void load(const QVector<Action> &source);
+    bool step();                            // Avanza un ciclo; true si la simulación terminó
+    SyncRunResult runToCompletion();
+
+    int cycle() const { return currentCycle; }
+    bool allCompleted() const { return grantedCount == actions.size(); }
+    const QVector<Action> &results() const { return actions; }
+    const QVector<SyncEvent> &lastEvents() const { return cycleEvents; }
+    QVector<int> waitingActions(const QString &resource) const;    // Cola de espera, índices de results()
+
+    static SimulationSummary summarize(const QVector<Action> &results, int finalCycle);
+
+private:
+    SyncConfig config;
+    bool keepHistory;
+    QVector<Action> actions;
+    QMap<QString, bool> resourceInUse;
+    QMap<QString, int> semaphoreCounts;
+    std::pmr::monotonic_buffer_resource arena;      // Se declara antes de lo que reparte
+    QMap<QString, int> resourceIndex;               // Posición de cada recurso en waitingQueues
+    std::pmr::vector<std::pmr::deque<Action*>> waitingQueues{&arena};
+    QMap<QString, RwLockState> rwLocks;
+    TimerWheel<Action*> releaseWheel;
+    std::vector<Action*> dueReleases;
+    QVector<Action*> grantedThisCycle;
+    QVector<SyncEvent> cycleEvents;
+    int nextArrival;
+    int grantedCount;
+    int currentCycle;
+    bool started;
+
+    WakeupPolicy wakeupPolicyFor(const QString &resource) const;
+    bool tryAccessResource(Action* action, bool fromQueue = false);
+    void releaseResource(const Action &action);
+    void processWaitingActions();
+    std::pmr::deque<Action*> &waitingQueue(const QString &resource);
+    void processReaderWriterQueue(const QString &resource, std::pmr::deque<Action*> &queue);
+    void grantFromQueue(Action* action);
+    void markGranted(Action* action);
+    void recordEvent(Action* action, SyncEventKind kind);
+    bool waitingQueuesEmpty() const;
+};
+
+// Simula cada recurso como un fragmento independiente en varios hilos y mezcla los
+// resultados en una sola línea de tiempo ordenada por ciclo. Las acciones de recursos
+// distintos nunca interactúan, así que el resultado coincide con la corrida serial.
+SyncRunResult runShardedSimulation(const SyncConfig &config, const QVector<Action> &actions, int threads = 0);
+
+// Lee un archivo de acciones. Formato: PID, ACCION, RECURSO, CICLO[, DURACION]
+QVector<Action> parseActions(const QString &content);
+
+// Lee un archivo de recursos. Formato: NOMBRE_RECURSO, CONTADOR[, ONE|ALL]; devuelve cuántos
+// recursos leyó. La política de despertar solo se guarda si se pasa `policies`.
+int parseResources(const QString &content, QMap<QString, int> &capacity,
+                   QMap<QString, WakeupPolicy> *policies = nullptr);
+
+// Línea de tiempo de una corrida en carriles sin solape; el dueño de cada tramo es el índice
+// de la acción. Una acción ocupa siempre el mismo carril y los carriles se llenan desde el 0,
+// así que dibujar o consultar un ciclo no recorre las acciones ni copia estados por ciclo.
+struct SyncTimeline {
+    QVector<Timeline> holding;  // Ciclos en que la acción retiene el recurso
+    QVector<Timeline> waiting;  // Ciclos en la cola de espera
+    int finalCycle = -1;        // -1 si no hay corrida
+    bool isEmpty() const { return finalCycle == -1; }
+};
+
+SyncTimeline buildSyncTimeline(const QVector<Action> &actions, int finalCycle);
+
+// Acciones visibles en un ciclo, en el orden en que se apilan: primero las que retienen el
+// recurso y luego las que esperan, cada grupo por carril
+struct SyncColumn {
+    QVector<int> holding;
+    QVector<int> waiting;
+};
+
+// Salto a cualquier ciclo de una SyncTimeline. Guarda los cambios de ocupación de cada
+// carril (se ocupa con una acción o se libera) ordenados por ciclo y, cada KEYFRAME_STRIDE
+// ciclos con cambios, una foto de los carriles ocupados. stateAt() parte de la foto anterior
+// al ciclo y aplica solo los cambios de esa ventana, así que el costo no depende de qué tan
+// lejos esté el ciclo del inicio. La memoria crece con los cambios más las fotos, que son
+// a lo sumo una por ventana de ciclos.
+class SyncReplay
+{
+public:
+    SyncReplay() = default;
+    explicit SyncReplay(const SyncTimeline &timeline);
+
+    SyncColumn stateAt(int cycle) const;
+    int keyframeCount() const { return keyframes.size(); }
+
+private:
+    static const int KEYFRAME_STRIDE = 64;
+
+    struct Change {
+        int cycle;
+        int slot;       // Carril; los de espera van después de los de retención
+        int action;     // -1 si el carril se libera
+    };
+
+    // Estado antes de los cambios de `cycle` en adelante
+    struct Keyframe {
+        int cycle;
+        int change;     // Primer cambio que falta aplicar
+        QVector<QPair<int, int>> occupied;  // (carril, acción), por carril
+    };
+
+    QVector<Change> changes;
+    QVector<Keyframe> keyframes;
+    int holdingLanes = 0;
+    int slotCount = 0;  // Carriles de retención más los de espera
+};
+
+#endif // SYNCENGINE_H
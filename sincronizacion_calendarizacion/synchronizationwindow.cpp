@@ -3,12 +3,72 @@
 #include <QFileDialog>
 #include <QFile>
 #include <QTextStream>
-#include <QDebug>
 #include <QGraphicsRectItem>
 #include <QGraphicsTextItem>
 #include <QPen>
 #include <QBrush>
+#include <QElapsedTimer>
+#include <QTableWidgetItem>
+#include <QHeaderView>
+#include <QSignalBlocker>
 #include <algorithm>
+#include "syncplanner.h"
+#include "scriptengine.h"
+#include "diagnosticsdialog.h"
+#include <QStatusBar>
+#include <memory>
+
+namespace {
+
+// Los cuadros de texto solo muestran el principio de archivos grandes: llenarlos enteros
+// tardaría más que parsearlos
+class TextPreview
+{
+public:
+    void append(const QString &chunk)
+    {
+        int lines = chunk.count('\n');
+        if (shownLines < MAX_LINES) {
+            int take = 0;
+            int position = 0;
+            while (shownLines < MAX_LINES && position < chunk.size()) {
+                int end = chunk.indexOf('\n', position);
+                position = end == -1 ? chunk.size() : end + 1;
+                shownLines++;
+                take++;
+            }
+            shown += chunk.left(position);
+            lines -= take;
+        }
+        omittedLines += std::max(lines, 0);
+    }
+
+    QString text() const
+    {
+        if (omittedLines == 0) return shown;
+        return shown + QString("... (%1 líneas más)\n").arg(omittedLines);
+    }
+
+private:
+    static const int MAX_LINES = 2000;
+    QString shown;
+    int shownLines = 0;
+    int omittedLines = 0;
+};
+
+struct ResourceFile {
+    TextPreview preview;
+    QMap<QString, int> capacity;
+    QMap<QString, WakeupPolicy> policies;
+};
+
+// Formato: NOMBRE_RECURSO, CONTADOR[, ONE|ALL]; devuelve cuántos recursos leyó
+int parseResourceLines(const QString &content, ResourceFile &out)
+{
+    return parseResources(content, out.capacity, &out.policies);
+}
+
+}
 
 SynchronizationWindow::SynchronizationWindow(QWidget *parent) :
     QMainWindow(parent),
@@ -23,19 +83,62 @@ SynchronizationWindow::SynchronizationWindow(QWidget *parent) :
     connect(ui->btnLoadResources, &QPushButton::clicked, this, &SynchronizationWindow::onLoadResourcesClicked);
     connect(ui->btnLoadActions, &QPushButton::clicked, this, &SynchronizationWindow::onLoadActionsClicked);
     connect(ui->btnRunSimulation, &QPushButton::clicked, this, &SynchronizationWindow::onRunSimulationClicked);
+    connect(ui->btnRunRealThreads, &QPushButton::clicked, this, &SynchronizationWindow::onRunRealThreadsClicked);
+    connect(ui->btnPlanCapacity, &QPushButton::clicked, this, &SynchronizationWindow::onPlanCapacityClicked);
+    connect(ui->btnExportMetrics, &QPushButton::clicked, this, &SynchronizationWindow::onExportMetricsClicked);
+    connect(ui->btnRunScript, &QPushButton::clicked, this, &SynchronizationWindow::onRunScriptClicked);
+    connect(ui->btnDiagnostics, &QPushButton::clicked, this, &SynchronizationWindow::onDiagnosticsClicked);
     connect(ui->cbSyncType, QOverload<int>::of(&QComboBox::currentIndexChanged),
             this, &SynchronizationWindow::onSyncTypeChanged);
+    connect(ui->cbRwPolicy, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &SynchronizationWindow::onRwPolicyChanged);
+    connect(ui->cbLogLevel, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &SynchronizationWindow::onLogLevelChanged);
+
+    // El registro se vuelca a la interfaz a lo sumo cinco veces por segundo
+    logger.setLevel(LogLevel::Debug);
+    logFlusher = new LogFlusher(logger, ui->txtLog, 200, this);
+    ui->txtLog->document()->setMaximumBlockCount(20000);
+    profile.addRate("decisiones_por_s", "decisiones", "motor");
+
+    // Los archivos se leen en un hilo aparte; el progreso y el botón de cancelar van en la barra de estado
+    loader = new FileLoader(this);
+    statusBar()->addPermanentWidget(new LoadProgressPanel(loader, this));
+    connect(loader, &FileLoader::started, this, [this]() {
+        ui->btnRunSimulation->setEnabled(false);
+    });
+    connect(loader, &FileLoader::finished, this, [this](bool completed, const QString &error) {
+        ui->btnRunSimulation->setEnabled(true);
+        if (!error.isEmpty()) {
+            logMessage(error, LogLevel::Error);
+        } else if (!completed) {
+            logMessage("Carga cancelada; se conservan los datos anteriores");
+        }
+    });
 
     simulationTimer = new QTimer(this);
     connect(simulationTimer, &QTimer::timeout, this, &SynchronizationWindow::runSimulationStep);
 
     useSemaphore = false;
+    useReaderWriter = false;
+    rwPolicy = RwPolicy::ReaderPreferring;
+    ui->cbRwPolicy->setEnabled(false);
     currentCycle = 0;
     maxCycles = 0;
     simulationRunning = false;
+    hasMetrics = false;
+
+    ui->tblMetrics->setColumnCount(9);
+    ui->tblMetrics->setHorizontalHeaderLabels({"Recurso", "Accesos", "Utilización", "Espera media",
+                                               "p95", "p99", "Máx.", "Cola máx.", "Accesos/ciclo"});
+    ui->tblMetrics->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    ui->tblMetrics->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    ui->btnExportMetrics->setEnabled(false);
 
     displayTimer = new QTimer(this);
     connect(displayTimer, &QTimer::timeout, this, &SynchronizationWindow::showNextCycle);
+    connect(ui->sliderCycle, &QSlider::valueChanged, this, &SynchronizationWindow::onCycleSliderChanged);
+    ui->sliderCycle->setEnabled(false);
 
     displayCycle = -1;
 
@@ -51,15 +154,44 @@ SynchronizationWindow::SynchronizationWindow(QWidget *parent) :
 
 SynchronizationWindow::~SynchronizationWindow()
 {
+    // Los hilos reales sueltan sus recursos y terminan; el reporte pendiente se descarta con la ventana
+    stopRealThreads = true;
+    if (realThreadWorker.joinable()) realThreadWorker.join();
+    // El plan pendiente se descarta con la ventana
+    if (plannerWorker.joinable()) plannerWorker.join();
     delete ui;
 }
 
 void SynchronizationWindow::onSyncTypeChanged(int index)
 {
     useSemaphore = (index == 1);
+    useReaderWriter = (index == 2);
     ui->btnLoadResources->setEnabled(useSemaphore);
+    ui->cbRwPolicy->setEnabled(useReaderWriter);
     resetSimulation();
-    logMessage(QString("Modo cambiado a: %1").arg(useSemaphore ? "Semáforo" : "Mutex"));
+    logMessage(QString("Modo cambiado a: %1").arg(modeName()));
+}
+
+void SynchronizationWindow::onRwPolicyChanged(int index)
+{
+    switch (index) {
+    case 1: rwPolicy = RwPolicy::WriterPreferring; break;
+    case 2: rwPolicy = RwPolicy::Fair; break;
+    default: rwPolicy = RwPolicy::ReaderPreferring; break;
+    }
+    resetSimulation();
+}
+
+QString SynchronizationWindow::modeName() const
+{
+    if (useReaderWriter) {
+        switch (rwPolicy) {
+        case RwPolicy::ReaderPreferring: return "Lector-Escritor (prefiere lectores)";
+        case RwPolicy::WriterPreferring: return "Lector-Escritor (prefiere escritores)";
+        case RwPolicy::Fair: return "Lector-Escritor (justo)";
+        }
+    }
+    return useSemaphore ? "Semáforo" : "Mutex";
 }
 
 void SynchronizationWindow::onLoadResourcesClicked()
@@ -69,17 +201,23 @@ void SynchronizationWindow::onLoadResourcesClicked()
     QString filePath = QFileDialog::getOpenFileName(this, "Abrir archivo de recursos", "", "Archivos de texto (*.txt)");
     if (filePath.isEmpty()) return;
 
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        logMessage("Error al abrir el archivo de recursos");
-        return;
+    // Leer y parsear en el hilo de carga; la ventana solo recibe el resultado completo
+    auto loaded = std::make_shared<ResourceFile>();
+    auto consume = [loaded](const QString &chunk, int) {
+        loaded->preview.append(chunk);
+        return parseResourceLines(chunk, *loaded);
+    };
+    auto done = [this, loaded](const LoadStats &stats) {
+        SIM_TIME(profile, "lectura_archivo", stats.nanoseconds);
+        ui->txtResources->setPlainText(loaded->preview.text());
+        semaphoreCapacity = std::move(loaded->capacity);
+        resourcePolicies = std::move(loaded->policies);
+        logMessage(QString("Cargados %1 recursos").arg(semaphoreCapacity.size()));
+    };
+
+    if (!loader->start(filePath, consume, done)) {
+        logMessage("Error: Ya hay un archivo cargándose", LogLevel::Error);
     }
-
-    QTextStream in(&file);
-    QString content = in.readAll();
-    ui->txtResources->setPlainText(content);
-    parseResourceFile(content);
-    file.close();
 }
 
 void SynchronizationWindow::onLoadActionsClicked()
@@ -87,70 +225,56 @@ void SynchronizationWindow::onLoadActionsClicked()
     QString filePath = QFileDialog::getOpenFileName(this, "Abrir archivo de acciones", "", "Archivos de texto (*.txt)");
     if (filePath.isEmpty()) return;
 
-    QFile file(filePath);
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        logMessage("Error al abrir el archivo de acciones");
-        return;
+    struct ActionFile {
+        TextPreview preview;
+        QVector<Action> actions;
+    };
+    auto loaded = std::make_shared<ActionFile>();
+    auto consume = [loaded](const QString &chunk, int) {
+        loaded->preview.append(chunk);
+        QVector<Action> parsed = parseActions(chunk);
+        loaded->actions += parsed;
+        return int(parsed.size());
+    };
+    auto done = [this, loaded](const LoadStats &stats) {
+        SIM_TIME(profile, "lectura_archivo", stats.nanoseconds);
+        ui->txtActions->setPlainText(loaded->preview.text());
+        // La corrida anterior apunta a las acciones viejas por índice
+        resetSimulation();
+        actions = std::move(loaded->actions);
+        indexActions();
+    };
+
+    if (!loader->start(filePath, consume, done)) {
+        logMessage("Error: Ya hay un archivo cargándose", LogLevel::Error);
     }
-
-    QTextStream in(&file);
-    QString content = in.readAll();
-    ui->txtActions->setPlainText(content);
-    parseActionFile(content);
-    file.close();
 }
 
 void SynchronizationWindow::parseResourceFile(const QString &content)
 {
-    semaphoreCounts.clear();
-    QStringList lines = content.split('\n', Qt::SkipEmptyParts);
-
-    for (const QString &line : lines) {
-        QStringList parts = line.split(',', Qt::SkipEmptyParts);
-        if (parts.size() == 2) {
-            QString resourceName = parts[0].trimmed();
-            int count = parts[1].trimmed().toInt();
-            semaphoreCounts[resourceName] = count;
-        }
-    }
+    SIM_PHASE(profile, "parseo");
+    ResourceFile parsed;
+    parseResourceLines(content, parsed);
+    semaphoreCapacity = std::move(parsed.capacity);
+    resourcePolicies = std::move(parsed.policies);
 
-    logMessage(QString("Cargados %1 recursos").arg(semaphoreCounts.size()));
+    logMessage(QString("Cargados %1 recursos").arg(semaphoreCapacity.size()));
 }
 
-void SynchronizationWindow::parseActionFile(const QString &content)
+// Colores por proceso y último ciclo de llegada de las acciones recién cargadas
+void SynchronizationWindow::indexActions()
 {
-    actions.clear();
+    SIM_PHASE(profile, "parseo");
     processColors.clear();
-    QStringList lines = content.split('\n', Qt::SkipEmptyParts);
-
-    for (const QString &line : lines) {
-        QStringList parts = line.split(',', Qt::SkipEmptyParts);
-        if (parts.size() == 4) {
-            Action a;
-            a.PID = parts[0].trimmed();
-            a.action = parts[1].trimmed().toUpper();
-            a.resource = parts[2].trimmed();
-            a.cycle = parts[3].trimmed().toInt();
-            a.completed = false;
-            a.completionCycle = -1;
-            a.waitingSince = -1;
-            actions.append(a);
-
-            if (!processColors.contains(a.PID)) {
-                uint hash = qHash(a.PID);
-                processColors[a.PID] = QColor::fromHsv(hash % 360, 255, 200);
-            }
 
-            if (a.cycle > maxCycles) {
-                maxCycles = a.cycle;
-            }
+    for (const Action &a : actions) {
+        if (!processColors.contains(a.PID)) {
+            uint hash = qHash(a.PID);
+            processColors[a.PID] = QColor::fromHsv(hash % 360, 255, 200);
+        }
 
-            if (!resourceInUse.contains(a.resource)) {
-                resourceInUse[a.resource] = false;
-            }
-            if (!semaphoreCounts.contains(a.resource) && useSemaphore) {
-                semaphoreCounts[a.resource] = 1;
-            }
+        if (a.cycle > maxCycles) {
+            maxCycles = a.cycle;
         }
     }
 
@@ -160,293 +284,698 @@ void SynchronizationWindow::parseActionFile(const QString &content)
 void SynchronizationWindow::onRunSimulationClicked()
 {
     if (actions.isEmpty()) {
-        logMessage("Error: No hay acciones para ejecutar la simulación");
+        logMessage("Error: No hay acciones para ejecutar la simulación", LogLevel::Error);
         return;
     }
 
-    if (useSemaphore && semaphoreCounts.isEmpty()) {
-        logMessage("Error: Modo semáforo requiere recursos");
+    if (useSemaphore && semaphoreCapacity.isEmpty()) {
+        logMessage("Error: Modo semáforo requiere recursos", LogLevel::Error);
         return;
     }
 
     resetSimulation();
-    prepareSimulation();
 
-    scene->clear();
+    logFlusher->discardPending();
     ui->txtLog->clear();
-    logMessage(QString("Iniciando simulación en modo %1").arg(useSemaphore ? "Semáforo" : "Mutex"));
+    logMessage(QString("Iniciando simulación en modo %1").arg(modeName()));
+
+    if (ui->chkShardedRun->isChecked()) {
+        // Cada recurso se simula en paralelo y los eventos se mezclan por ciclo
+        QElapsedTimer elapsed;
+        elapsed.start();
+        SyncRunResult result;
+        {
+            SIM_PHASE(profile, "motor");
+            result = runShardedSimulation(currentConfig(), actions);
+        }
+        SIM_COUNT(profile, "decisiones", result.events.size());
+        SIM_COUNT(profile, "ciclos", result.finalCycle + 1);
+        logMessage(QString("Simulación paralela por recurso: %1 ciclos en %2 ms")
+                       .arg(result.finalCycle + 1)
+                       .arg(elapsed.elapsed()));
+
+        for (const SyncEvent &event : result.events) {
+            logEvent(event, result.actions);
+        }
+        finishSimulation(result);
+        return;
+    }
+
+    engine.reset(new SyncEngine(currentConfig(), false));
+    engine->load(actions);
 
     simulationRunning = true;
     simulationTimer->start(1000);
 }
 
-void SynchronizationWindow::prepareSimulation()
+void SynchronizationWindow::onRunRealThreadsClicked()
 {
-    for (auto it = resourceInUse.begin(); it != resourceInUse.end(); ++it) {
-        it.value() = false;
-        waitingQueues[it.key()] = std::queue<Action*>();
+    if (simulationRunning || timeline.isEmpty() || scriptShown) {
+        logMessage("Error: Ejecute primero la simulación para comparar con hilos reales", LogLevel::Error);
+        return;
+    }
+    if (realThreadsRunning) {
+        logMessage("Error: Ya hay una corrida con hilos reales en curso", LogLevel::Error);
+        return;
+    }
+    if (planning) {
+        logMessage("Error: Espere a que termine la planificación de permisos", LogLevel::Error);
+        return;
     }
 
-    if (useSemaphore) {
-        for (auto it = semaphoreCounts.begin(); it != semaphoreCounts.end(); ++it) {
-            resourceInUse[it.key()] = false;
+    // Duración real de un ciclo simulado
+    const int REAL_CYCLE_US = 2000;
+
+    QMap<QString, int> processIndex;
+    QMap<QString, int> resourceIndex;
+    std::vector<int> permits;
+    std::vector<RealThreadJob> jobs;
+    jobs.reserve(actions.size());
+
+    for (const Action &action : actions) {
+        if (!processIndex.contains(action.PID)) {
+            processIndex.insert(action.PID, processIndex.size());
+        }
+        if (!resourceIndex.contains(action.resource)) {
+            resourceIndex.insert(action.resource, resourceIndex.size());
+            permits.push_back(semaphoreCapacity.value(action.resource, 1));
         }
+        jobs.push_back({processIndex.value(action.PID),
+                        resourceIndex.value(action.resource),
+                        action.action == "WRITE",
+                        action.cycle,
+                        action.holdCycles});
     }
 
-    std::sort(actions.begin(), actions.end(), [](const Action &a, const Action &b) {
-        if (a.cycle == b.cycle) return a.PID < b.PID;
-        return a.cycle < b.cycle;
+    RealPrimitive primitive = RealPrimitive::Mutex;
+    if (useReaderWriter) primitive = RealPrimitive::SharedMutex;
+    else if (useSemaphore) primitive = RealPrimitive::Semaphore;
+
+    logMessage(QString("Ejecutando %1 acciones en %2 hilos reales (%3 us por ciclo)...")
+                   .arg(jobs.size())
+                   .arg(processIndex.size())
+                   .arg(REAL_CYCLE_US));
+
+    // La corrida duerme en tiempo real, así que va en un hilo aparte como las cargas de archivos
+    if (realThreadWorker.joinable()) realThreadWorker.join();     // Ya terminó; solo falta unirlo
+    realThreadsRunning = true;
+    stopRealThreads = false;
+    ui->btnRunRealThreads->setEnabled(false);
+    const int generation = runGeneration;
+    const int processCount = processIndex.size();
+    realThreadWorker = std::thread([this, primitive, permits, jobs, processCount, generation, REAL_CYCLE_US]() {
+        RealThreadRunner runner(primitive, permits, std::chrono::microseconds(REAL_CYCLE_US));
+        RealThreadReport report = runner.run(jobs, processCount, stopRealThreads);
+        QMetaObject::invokeMethod(this, [this, report, generation, REAL_CYCLE_US]() {
+            showRealThreadReport(report, generation, REAL_CYCLE_US);
+        }, Qt::QueuedConnection);
     });
-
-    currentCycle = 0;
 }
 
-bool SynchronizationWindow::tryAccessResource(Action* action)
+void SynchronizationWindow::showRealThreadReport(const RealThreadReport &report, int generation, int cycleUs)
 {
-    if (useSemaphore) {
-        if (semaphoreCounts.contains(action->resource)) {
-            if (semaphoreCounts[action->resource] > 0) {
-                semaphoreCounts[action->resource]--;
-                return true;
-            }
-        }
-    } else {
-        if (!resourceInUse[action->resource]) {
-            resourceInUse[action->resource] = true;
-            return true;
-        }
+    realThreadsRunning = false;
+    ui->btnRunRealThreads->setEnabled(true);
+    if (generation != runGeneration) {
+        logMessage("Corrida con hilos reales descartada: la simulación cambió mientras corría");
+        return;
     }
-    return false;
+
+    const bool logEachAction = logger.enabled(LogLevel::Debug);
+    logMessage("Espera simulada frente a espera real (en ciclos):", LogLevel::Debug);
+    for (int i = 0; i < actions.size(); ++i) {
+        Action &action = actions[i];
+        const RealThreadSample &sample = report.samples[i];
+        action.realWaitCycles = sample.latencyUs < 0 ? -1 : sample.latencyUs / cycleUs;
+        if (!logEachAction) continue;
+        int simulatedWait = action.completionCycle == -1 ? -1 : action.completionCycle - action.cycle;
+        logMessage(QString("  %1 %2 %3 ciclo %4: simulado %5, real %6 (%7 us)")
+                       .arg(action.PID)
+                       .arg(action.action)
+                       .arg(action.resource)
+                       .arg(action.cycle)
+                       .arg(simulatedWait)
+                       .arg(action.realWaitCycles, 0, 'f', 2)
+                       .arg(sample.latencyUs, 0, 'f', 0),
+                   LogLevel::Debug);
+    }
+
+    logMessage(QString("Hilos reales: %1 ms, %2 adquisiciones/s, latencia media %3 us, p99 %4 us, máxima %5 us")
+                   .arg(report.wallTimeMs, 0, 'f', 2)
+                   .arg(report.acquisitionsPerSecond, 0, 'f', 0)
+                   .arg(report.meanLatencyUs, 0, 'f', 1)
+                   .arg(report.p99LatencyUs, 0, 'f', 1)
+                   .arg(report.maxLatencyUs, 0, 'f', 1));
+    if (report.skipped > 0) {
+        logMessage(QString("  %1 acciones sobre recursos sin permisos no se ejecutaron, como en la simulación")
+                       .arg(report.skipped));
+    }
+
+    // Volver a dibujar lo ya mostrado para que los bloques muestren la espera real
+    timelineActions = actions;
+    int shownCycle = drawnCycle;
+    clearTimelineScene();
+    drawAccumulatedCycles(shownCycle);
 }
 
-void SynchronizationWindow::releaseResource(const QString &resource)
+void SynchronizationWindow::onRunScriptClicked()
 {
-    if (useSemaphore) {
-        if (semaphoreCounts.contains(resource)) {
-            semaphoreCounts[resource]++;
+    QString filePath = QFileDialog::getOpenFileName(this, "Abrir guion de procesos", "", "Archivos de texto (*.txt)");
+    if (filePath.isEmpty()) return;
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        logMessage("Error al abrir el guion de procesos", LogLevel::Error);
+        return;
+    }
+
+    QTextStream in(&file);
+    ScriptProgram program = parseScriptFile(in.readAll());
+    file.close();
+
+    if (program.processCount() == 0) {
+        logMessage("Error: El guion no contiene procesos", LogLevel::Error);
+        return;
+    }
+
+    resetSimulation();
+    logFlusher->discardPending();
+    ui->txtLog->clear();
+
+    // Sin modo semáforo cada recurso es un mutex
+    QMap<QString, int> capacity = useSemaphore ? semaphoreCapacity : QMap<QString, int>();
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+    ScriptEngine scriptEngine(program, capacity);
+    ScriptRunResult result = scriptEngine.runToCompletion();
+
+    logMessage(QString("Guion: %1 procesos, %2 pasos, %3 ciclos en %4 ms")
+                   .arg(program.processCount())
+                   .arg(program.steps.size())
+                   .arg(result.finalCycle + 1)
+                   .arg(elapsed.elapsed()));
+    logMessage(QString("  %1 procesos terminaron, %2 quedaron bloqueados, %3 ciclos de espera en total")
+                   .arg(result.finishedProcesses)
+                   .arg(result.blockedProcesses.size())
+                   .arg(result.totalBlockedCycles));
+
+    if (!result.blockedProcesses.empty()) {
+        const int MAX_LISTED = 20;
+        QStringList names;
+        for (int i = 0; i < int(result.blockedProcesses.size()) && i < MAX_LISTED; ++i) {
+            names << program.processNames.at(result.blockedProcesses[i]);
         }
+        if (int(result.blockedProcesses.size()) > MAX_LISTED) names << "...";
+        logMessage("Procesos bloqueados al final: " + names.join(", "));
+    }
+
+    for (const ScriptDeadlock &deadlock : result.deadlocks) {
+        const int MAX_LISTED = 20;
+        const int length = int(deadlock.processes.size());
+        QStringList links;
+        for (int i = 0; i < length && i < MAX_LISTED; ++i) {
+            links << QString("%1 espera %2 (retenido por %3)")
+                         .arg(program.processNames.at(deadlock.processes[i]))
+                         .arg(program.resourceNames.at(deadlock.resources[i]))
+                         .arg(program.processNames.at(deadlock.processes[(i + 1) % length]));
+        }
+        if (length > MAX_LISTED) links << QString("... (%1 procesos en el ciclo)").arg(length);
+        logMessage(QString("Interbloqueo en ciclo %1: %2; %3 procesos atrapados")
+                       .arg(deadlock.cycle)
+                       .arg(links.join(" -> "))
+                       .arg(deadlock.trappedProcesses),
+                   LogLevel::Error);
+    }
+
+    // Cada proceso que se bloquea detrás de un hallazgo anterior es otro hallazgo: se listan los primeros
+    const int MAX_STARVATIONS = 20;
+    for (int i = 0; i < int(result.starvations.size()) && i < MAX_STARVATIONS; ++i) {
+        const ScriptStarvation &starvation = result.starvations[i];
+        QString reason = starvation.zeroCapacity ? "que no tiene permisos ni retenedores"
+                                                 : "detrás de procesos ya atrapados";
+        logMessage(QString("Inanición en ciclo %1: %2 espera %3 %4; %5 procesos atrapados")
+                       .arg(starvation.cycle)
+                       .arg(program.processNames.at(starvation.process))
+                       .arg(program.resourceNames.at(starvation.resource))
+                       .arg(reason)
+                       .arg(starvation.trappedProcesses),
+                   LogLevel::Error);
+    }
+    if (int(result.starvations.size()) > MAX_STARVATIONS) {
+        logMessage(QString("... y %1 procesos más en inanición")
+                       .arg(int(result.starvations.size()) - MAX_STARVATIONS),
+                   LogLevel::Error);
+    }
+
+    // Cada ACQUIRE del guion se muestra como una acción en la línea de tiempo y en las métricas;
+    // las acciones cargadas no se tocan y siguen disponibles para simular
+    timelineActions = result.acquisitions;
+    scriptShown = true;
+    currentCycle = result.finalCycle;
+    lastMetrics = computeSyncMetrics(timelineActions, currentCycle, capacity);
+    hasMetrics = true;
+    showMetrics(lastMetrics);
+
+    const int MAX_DRAWN_ACQUISITIONS = 2000;
+    if (timelineActions.size() <= MAX_DRAWN_ACQUISITIONS) {
+        timeline = buildSyncTimeline(timelineActions, currentCycle);
+        startReplay();
     } else {
-        resourceInUse[resource] = false;
+        logMessage(QString("Línea de tiempo omitida: %1 adquisiciones superan el máximo dibujable (%2)")
+                       .arg(timelineActions.size())
+                       .arg(MAX_DRAWN_ACQUISITIONS));
     }
 }
 
-bool SynchronizationWindow::waitingQueuesEmpty() const
+void SynchronizationWindow::onPlanCapacityClicked()
 {
-    for (const auto &queue : waitingQueues) {
-        if (!queue.empty()) {
-            return false;
-        }
+    if (actions.isEmpty()) {
+        logMessage("Error: Cargue un archivo de acciones antes de planificar", LogLevel::Error);
+        return;
+    }
+    // Al terminar, el plan pasa a modo semáforo y reinicia la simulación
+    if (simulationRunning || displayTimer->isActive() || realThreadsRunning) {
+        logMessage("Error: Espere a que termine la simulación o la corrida con hilos reales para planificar", LogLevel::Error);
+        return;
     }
-    return true;
+    if (planning) {
+        logMessage("Error: Ya hay una planificación en curso", LogLevel::Error);
+        return;
+    }
+
+    PlannerRequest request;
+    request.base = currentConfig();
+    request.target = ui->cbPlannerTarget->currentIndex() == 1 ? PlannerTarget::P99Wait : PlannerTarget::MaxWait;
+    request.targetCycles = ui->spinPlannerTarget->value();
+
+    logMessage(QString("Planificando permisos para %1 acciones...").arg(actions.size()));
+
+    // Son varias simulaciones completas por recurso: van en un hilo aparte como los hilos reales
+    if (plannerWorker.joinable()) plannerWorker.join();     // Ya terminó; solo falta unirlo
+    planning = true;
+    ui->btnPlanCapacity->setEnabled(false);
+    const int generation = runGeneration;
+    const QVector<Action> source = actions;
+    plannerWorker = std::thread([this, source, request, generation]() {
+        QElapsedTimer elapsed;
+        elapsed.start();
+        PlannerResult plan = planSemaphoreCapacity(source, request);
+        qint64 elapsedMs = elapsed.elapsed();
+        QMetaObject::invokeMethod(this, [this, plan, request, elapsedMs, generation]() {
+            showCapacityPlan(plan, request, elapsedMs, generation);
+        }, Qt::QueuedConnection);
+    });
 }
 
-void SynchronizationWindow::processWaitingActions()
+void SynchronizationWindow::showCapacityPlan(const PlannerResult &plan, const PlannerRequest &request,
+                                             qint64 elapsedMs, int generation)
 {
-    for (auto it = waitingQueues.begin(); it != waitingQueues.end(); ++it) {
-        std::queue<Action*>& queue = it.value();
-        if (queue.empty()) continue;
+    planning = false;
+    ui->btnPlanCapacity->setEnabled(true);
+    if (generation != runGeneration) {
+        logMessage("Planificación descartada: las acciones o el modo cambiaron mientras corría");
+        return;
+    }
 
-        Action* action = queue.front();
-        if (tryAccessResource(action)) {
-            action->completed = true;
-            action->completionCycle = currentCycle;
-            queue.pop();
+    logMessage(QString("Planificación de permisos (%1 <= %2 ciclos): %3 simulaciones en %4 ms")
+                   .arg(request.target == PlannerTarget::P99Wait ? "espera p99" : "espera máxima")
+                   .arg(request.targetCycles)
+                   .arg(plan.simulations)
+                   .arg(elapsedMs));
+    for (auto it = plan.permits.begin(); it != plan.permits.end(); ++it) {
+        logMessage(QString("  %1: %2 permisos (espera %3 ciclos)")
+                       .arg(it.key())
+                       .arg(it.value())
+                       .arg(plan.achievedWait.value(it.key())));
+    }
 
-            logMessage(QString("Ciclo %1: Proceso %2 %3 %4 (ACCESSED desde cola)")
-                           .arg(currentCycle)
-                           .arg(action->PID)
-                           .arg(action->action)
-                           .arg(action->resource));
+    QString content = formatResourceFile(plan, resourcePolicies);
+    QString filePath = QFileDialog::getSaveFileName(this, "Guardar archivo de recursos optimizado",
+                                                    "recursos_optimizados.txt", "Archivos de texto (*.txt)");
+    if (!filePath.isEmpty()) {
+        QFile file(filePath);
+        if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            QTextStream out(&file);
+            out << content;
+            logMessage("Archivo de recursos guardado en " + filePath);
+        } else {
+            logMessage("Error al guardar el archivo de recursos", LogLevel::Error);
         }
     }
+
+    // Dejar cargados los permisos planificados en modo semáforo
+    ui->cbSyncType->setCurrentIndex(1);
+    ui->txtResources->setPlainText(content);
+    parseResourceFile(content);
 }
 
-void SynchronizationWindow::storeCurrentCycleState()
+SyncConfig SynchronizationWindow::currentConfig() const
 {
-    CycleState state;
-
-    // Guardar acciones completadas en este ciclo
-    for (Action &action : actions) {
-        if (action.completionCycle == currentCycle) {
-            state.accessedActions.append(action);
-        }
+    SyncConfig config;
+    if (useReaderWriter) {
+        config.mode = SyncMode::ReaderWriter;
+    } else if (useSemaphore) {
+        config.mode = SyncMode::Semaphore;
     }
+    config.rwPolicy = rwPolicy;
+    config.defaultWakeup = ui->cbWakeupPolicy->currentIndex() == 1 ? WakeupPolicy::WakeAll : WakeupPolicy::WakeOne;
+    config.resourcePolicies = resourcePolicies;
+    config.capacity = semaphoreCapacity;
+    return config;
+}
 
-    // Guardar acciones en espera en este ciclo
-    for (Action &action : actions) {
-        if ((action.waitingSince == currentCycle) ||
-            (action.waitingSince != -1 && !action.completed && action.waitingSince <= currentCycle)) {
-            state.waitingActions.append(action);
-        }
+void SynchronizationWindow::logEvent(const SyncEvent &event, const QVector<Action> &source)
+{
+    // Con un evento por acción, el formateo solo se paga si el nivel lo muestra
+    if (!logger.enabled(LogLevel::Debug)) return;
+
+    const Action &action = source[event.action];
+    QString status = "WAITING";
+    if (event.kind == SyncEventKind::Accessed) {
+        status = "ACCESSED";
+    } else if (event.kind == SyncEventKind::AccessedFromQueue) {
+        status = "ACCESSED desde cola";
     }
 
-    cycleStates.append(state);
+    logMessage(QString("Ciclo %1: Proceso %2 %3 %4 (%5)")
+                   .arg(event.cycle)
+                   .arg(action.PID)
+                   .arg(action.action)
+                   .arg(action.resource)
+                   .arg(status),
+               LogLevel::Debug);
 }
 
 void SynchronizationWindow::runSimulationStep()
 {
     if (!simulationRunning) return;
 
-    // Liberar recursos de acciones completadas en el ciclo anterior
-    for (Action &action : actions) {
-        if (action.completed && action.completionCycle == currentCycle - 1) {
-            releaseResource(action.resource);
-        }
+    bool finished;
+    {
+        SIM_PHASE(profile, "motor");
+        finished = engine->step();
+    }
+    SIM_COUNT(profile, "decisiones", engine->lastEvents().size());
+    SIM_COUNT(profile, "ciclos", 1);
+    currentCycle = engine->cycle();
+    for (const SyncEvent &event : engine->lastEvents()) {
+        logEvent(event, engine->results());
     }
 
-    processWaitingActions();
+    if (finished) {
+        simulationTimer->stop();
+        simulationRunning = false;
 
-    // Procesar acciones del ciclo actual
-    QVector<Action*> currentActions;
-    for (Action &action : actions) {
-        if (action.cycle == currentCycle && !action.completed) {
-            currentActions.append(&action);
-        }
+        SyncRunResult result;
+        result.actions = engine->results();
+        result.finalCycle = engine->cycle();
+        result.allCompleted = engine->allCompleted();
+        engine.reset();
+
+        finishSimulation(result);
     }
+}
 
-    for (Action* action : currentActions) {
-        if (tryAccessResource(action)) {
-            action->completed = true;
-            action->completionCycle = currentCycle;
-            logMessage(QString("Ciclo %1: Proceso %2 %3 %4 (ACCESSED)")
-                           .arg(currentCycle)
-                           .arg(action->PID)
-                           .arg(action->action)
-                           .arg(action->resource));
-        } else {
-            waitingQueues[action->resource].push(action);
-            action->waitingSince = currentCycle;
-            logMessage(QString("Ciclo %1: Proceso %2 %3 %4 (WAITING)")
-                           .arg(currentCycle)
-                           .arg(action->PID)
-                           .arg(action->action)
-                           .arg(action->resource));
+void SynchronizationWindow::finishSimulation(const SyncRunResult &result)
+{
+    actions = result.actions;
+    currentCycle = result.finalCycle;
+    timelineActions = actions;
+    timeline = buildSyncTimeline(actions, currentCycle);
+
+    if (!result.allCompleted) {
+        logMessage("Simulación terminada (procesos pendientes no pueden completarse)");
+
+        // Cada acción retiene un solo recurso y lo suelta al terminar su HOLD, así que no hay
+        // esperas circulares: lo pendiente solo puede deberse a recursos sin permisos
+        QMap<QString, int> pendingPerResource;
+        for (const Action &action : actions) {
+            if (!action.completed) pendingPerResource[action.resource]++;
         }
+        for (auto it = pendingPerResource.begin(); it != pendingPerResource.end(); ++it) {
+            logMessage(QString("  %1 acciones sobre %2 nunca lo obtienen (%3 permisos)")
+                           .arg(it.value())
+                           .arg(it.key())
+                           .arg(useSemaphore ? semaphoreCapacity.value(it.key(), 1) : 1));
+        }
+    } else {
+        logMessage("Simulación completada");
     }
 
-    // Almacenar el estado actual antes de avanzar
-    storeCurrentCycleState();
-
-    // Verificar si la simulación ha terminado
-    bool allCompleted = true;
-    bool allProcessed = true;
+    // La ocupación se mide contra los permisos solo en modo semáforo
+    {
+        SIM_PHASE(profile, "metricas");
+        lastMetrics = computeSyncMetrics(actions, currentCycle, useSemaphore ? semaphoreCapacity : QMap<QString, int>());
+        hasMetrics = true;
+        showMetrics(lastMetrics);
+    }
 
-    for (const Action &action : actions) {
-        if (!action.completed) {
-            allCompleted = false;
-            if (action.cycle > currentCycle) {
-                allProcessed = false;
-            }
-        }
+    if (useSemaphore) {
+        logPolicyComparison();
+    } else if (useReaderWriter) {
+        logReaderWriterComparison();
     }
 
-    if (allCompleted || (allProcessed && waitingQueuesEmpty())) {
-        if (!allCompleted) {
-            logMessage("Simulación terminada (procesos pendientes no pueden completarse)");
-        } else {
-            logMessage("Simulación completada");
+    startReplay();
+}
+
+void SynchronizationWindow::showMetrics(const SyncMetrics &metrics)
+{
+    ui->tblMetrics->setRowCount(0);
+
+    auto addRow = [this](const QString &name, const ResourceMetrics &r) {
+        int row = ui->tblMetrics->rowCount();
+        ui->tblMetrics->insertRow(row);
+        QStringList values = {name,
+                              QString::number(r.accesses),
+                              QString("%1%").arg(r.utilization * 100, 0, 'f', 1),
+                              QString::number(r.meanWait, 'f', 2),
+                              QString::number(r.p95Wait),
+                              QString::number(r.p99Wait),
+                              QString::number(r.maxWait),
+                              QString::number(r.maxQueueDepth),
+                              QString::number(r.throughput, 'f', 2)};
+        for (int column = 0; column < values.size(); ++column) {
+            ui->tblMetrics->setItem(row, column, new QTableWidgetItem(values[column]));
         }
-        simulationTimer->stop();
-        simulationRunning = false;
+    };
 
-        // Iniciar la visualización paso a paso
-        displayCycle = -1;
-        displayTimer->start(1000);
-        return;
+    for (auto it = metrics.resources.begin(); it != metrics.resources.end(); ++it) {
+        addRow(it.key(), it.value());
     }
+    addRow("Total", metrics.overall);
 
-    currentCycle++;
+    QStringList blocked;
+    for (auto it = metrics.blockedCycles.begin(); it != metrics.blockedCycles.end(); ++it) {
+        blocked << QString("%1: %2").arg(it.key()).arg(it.value());
+    }
+    logMessage("Ciclos bloqueados por proceso: " + blocked.join(", "));
+    ui->btnExportMetrics->setEnabled(true);
 }
 
-void SynchronizationWindow::drawAccumulatedCycles(int upToCycle)
+void SynchronizationWindow::onExportMetricsClicked()
 {
-    scene->clear();
-
-    const int blockWidth = 100;
-    const int blockHeight = 70;
-    const int verticalSpacing = 15;
-    const int horizontalSpacing = 30;
-    const int startX = 20;
-    const int startY = 50;
-
-    // Calcular el ancho total necesario
-    int totalWidth = startX + (upToCycle + 1) * (blockWidth + horizontalSpacing) + 20;
-    int totalHeight = 800;  // Altura fija suficiente
+    if (!hasMetrics) {
+        logMessage("Error: Ejecute una simulación antes de exportar métricas", LogLevel::Error);
+        return;
+    }
 
-    scene->setSceneRect(0, 0, totalWidth, totalHeight);
+    QString filePath = QFileDialog::getSaveFileName(this, "Exportar métricas",
+                                                    "metricas_sincronizacion.csv", "Archivos CSV (*.csv)");
+    if (filePath.isEmpty()) return;
 
-    // Dibujar encabezados de ciclo
-    for (int cycle = 0; cycle <= upToCycle; cycle++) {
-        QGraphicsTextItem *cycleText = scene->addText(QString::number(cycle));
-        cycleText->setPos(startX + cycle * (blockWidth + horizontalSpacing) + blockWidth/2 - 10, startY - 30);
-
-        // Resaltar el ciclo más reciente
-        if (cycle == upToCycle) {
-            QGraphicsRectItem *highlight = scene->addRect(
-                startX + cycle * (blockWidth + horizontalSpacing) - 5, startY - 35,
-                blockWidth + 10, 25,
-                QPen(Qt::red, 2), Qt::NoBrush);
-        }
+    QFile file(filePath);
+    if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        QTextStream out(&file);
+        out << formatMetricsCsv(lastMetrics, modeName());
+        logMessage("Métricas exportadas a " + filePath);
+    } else {
+        logMessage("Error al exportar las métricas", LogLevel::Error);
     }
+}
 
-    // Dibujar todos los ciclos hasta upToCycle
-    for (int cycle = 0; cycle <= upToCycle; cycle++) {
-        int verticalOffset = 0;
-
-        // Dibujar acciones accedidas en este ciclo
-        for (Action &action : actions) {
-            if (action.completionCycle == cycle) {
-                int x = startX + cycle * (blockWidth + horizontalSpacing);
-                int y = startY + verticalOffset;
+SimulationSummary SynchronizationWindow::runHeadless(const SyncConfig &config)
+{
+    SIM_PHASE(profile, "motor_comparacion");
+    SyncEngine headless(config, false);
+    headless.load(actions);
+    SyncRunResult result = headless.runToCompletion();
+    return SyncEngine::summarize(result.actions, result.finalCycle);
+}
 
-                QGraphicsRectItem *rect = scene->addRect(x, y, blockWidth, blockHeight,
-                                                         QPen(Qt::black), QBrush(Qt::green));
+void SynchronizationWindow::logPolicyComparison()
+{
+    // La comparación fuerza la misma política en todos los recursos
+    SyncConfig config = currentConfig();
+    config.resourcePolicies.clear();
+
+    config.defaultWakeup = WakeupPolicy::WakeOne;
+    SimulationSummary one = runHeadless(config);
+    config.defaultWakeup = WakeupPolicy::WakeAll;
+    SimulationSummary all = runHeadless(config);
+
+    auto describe = [](const QString &name, const SimulationSummary &s) {
+        return QString("%1: %2 ciclos, %3 accesos/ciclo, espera promedio %4 ciclos, %5 pendientes")
+            .arg(name)
+            .arg(s.totalCycles)
+            .arg(s.throughput, 0, 'f', 2)
+            .arg(s.averageWait, 0, 'f', 2)
+            .arg(s.pendingActions);
+    };
+
+    logMessage("Comparación de políticas de despertar:");
+    logMessage(describe("  Uno por ciclo", one));
+    logMessage(describe("  En lote", all));
+}
 
-                QGraphicsTextItem *pidText = scene->addText(QString("%1 - %2").arg(action.PID).arg(action.resource));
-                pidText->setPos(x + 5, y + 5);
+void SynchronizationWindow::logReaderWriterComparison()
+{
+    SimulationSummary rw = SyncEngine::summarize(actions, currentCycle);
+
+    SyncConfig config = currentConfig();
+    config.mode = SyncMode::Mutex;
+    SimulationSummary mutex = runHeadless(config);
+
+    auto describe = [](const QString &name, const SimulationSummary &s) {
+        return QString("%1: %2 ciclos, %3 accesos/ciclo, espera promedio %4 ciclos, hasta %5 lecturas simultáneas")
+            .arg(name)
+            .arg(s.totalCycles)
+            .arg(s.throughput, 0, 'f', 2)
+            .arg(s.averageWait, 0, 'f', 2)
+            .arg(s.peakConcurrentReaders);
+    };
+
+    logMessage("Concurrencia de lectura frente a un mutex:");
+    logMessage(describe("  " + modeName(), rw));
+    logMessage(describe("  Mutex", mutex));
+}
 
-                QGraphicsTextItem *actionText = scene->addText(action.action);
-                actionText->setPos(x + 5, y + 25);
+namespace {
 
-                QGraphicsTextItem *statusText = scene->addText("ACCESSED");
-                statusText->setPos(x + 5, y + 45);
+const int BLOCK_WIDTH = 100;
+const int BLOCK_HEIGHT = 70;
+const int VERTICAL_SPACING = 15;
+const int HORIZONTAL_SPACING = 30;
+const int START_X = 20;
+const int START_Y = 50;
 
-                verticalOffset += blockHeight + verticalSpacing;
-            }
-        }
+int columnX(int cycle)
+{
+    return START_X + cycle * (BLOCK_WIDTH + HORIZONTAL_SPACING);
+}
 
-        // Dibujar acciones en espera en este ciclo
-        for (Action &action : actions) {
-            bool isWaiting = (action.waitingSince != -1) &&
-                             (!action.completed ||
-                              (action.completed && action.completionCycle > cycle));
+}
 
-            if (isWaiting && action.waitingSince <= cycle) {
-                int x = startX + cycle * (blockWidth + horizontalSpacing);
-                int y = startY + verticalOffset;
+// Deja dibujados los ciclos [0, upToCycle], una fila por carril de `timeline`: primero los de
+// retención y luego los de espera. Cada tramo es un solo rectángulo; avanzar alarga los que
+// siguen abiertos y agrega los que empiezan, y retroceder rehace la escena hasta el ciclo
+void SynchronizationWindow::drawAccumulatedCycles(int upToCycle)
+{
+    SIM_PHASE(profile, "escena");
 
-                QGraphicsRectItem *rect = scene->addRect(x, y, blockWidth, blockHeight,
-                                                         QPen(Qt::black), QBrush(QColor(255, 165, 0)));
+    if (upToCycle < drawnCycle) clearTimelineScene();
 
-                QGraphicsTextItem *pidText = scene->addText(QString("%1 - %2").arg(action.PID).arg(action.resource));
-                pidText->setPos(x + 5, y + 5);
+    for (int i = 0; i < clippedSegments.size();) {
+        ClippedSegment &clipped = clippedSegments[i];
+        clipped.rect->setRect(segmentArea(clipped.start, std::min(clipped.end, upToCycle + 1), clipped.row));
+        if (clipped.end <= upToCycle + 1) {
+            clippedSegments[i] = clippedSegments.last();
+            clippedSegments.removeLast();
+        } else {
+            ++i;
+        }
+    }
 
-                QGraphicsTextItem *actionText = scene->addText(action.action);
-                actionText->setPos(x + 5, y + 25);
+    // Tramos que empiezan en (drawnCycle, upToCycle]; los anteriores ya están en la escena
+    int added = 0;
+    const int holdingLanes = timeline.holding.size();
+    auto addLanes = [&](const QVector<Timeline> &lanes, int firstRow, bool holding) {
+        for (int lane = 0; lane < lanes.size(); ++lane) {
+            lanes[lane].forEach(drawnCycle + 1, upToCycle + 1, [&](const Timeline::Segment &segment) {
+                if (segment.start > drawnCycle) added += drawSegment(segment, firstRow + lane, holding, upToCycle);
+            });
+        }
+    };
+    addLanes(timeline.holding, 0, true);
+    addLanes(timeline.waiting, holdingLanes, false);
+    drawnCycle = upToCycle;
+
+    int rows = holdingLanes + timeline.waiting.size();
+    int totalWidth = columnX(upToCycle + 1) + 20;
+    int totalHeight = std::max(800, START_Y + rows * (BLOCK_HEIGHT + VERTICAL_SPACING) + 20);
+    scene->setSceneRect(0, 0, totalWidth, totalHeight);
 
-                QGraphicsTextItem *statusText = scene->addText("WAITING");
-                statusText->setPos(x + 5, y + 45);
+    // Resaltar el ciclo más reciente, con lo que pasa en él
+    if (!cycleHighlight) {
+        cycleHighlight = scene->addRect(0, 0, BLOCK_WIDTH + 10, 25, QPen(Qt::red, 2), Qt::NoBrush);
+        cycleStatus = scene->addText(QString());
+        added += 2;
+    }
+    cycleHighlight->setVisible(upToCycle >= 0);
+    cycleStatus->setVisible(upToCycle >= 0);
+    cycleHighlight->setPos(columnX(upToCycle) - 5, START_Y - 35);
+    if (upToCycle >= 0) {
+        SyncColumn column = replay.stateAt(upToCycle);
+        cycleStatus->setPlainText(QString("Ciclo %1: %2 retienen, %3 esperan")
+                                      .arg(upToCycle)
+                                      .arg(column.holding.size())
+                                      .arg(column.waiting.size()));
+        cycleStatus->setPos(columnX(upToCycle) + BLOCK_WIDTH + 10, START_Y - 35);
+    }
 
-                verticalOffset += blockHeight + verticalSpacing;
-            }
-        }
+    {
+        QSignalBlocker blocker(ui->sliderCycle);
+        ui->sliderCycle->setValue(std::max(upToCycle, 0));
     }
+    ui->lblCycle->setText(QString("%1 / %2").arg(std::max(upToCycle, 0)).arg(currentCycle));
 
     ui->graphicsView->fitInView(scene->sceneRect(), Qt::KeepAspectRatio);
     ui->graphicsView->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOn);
     ui->graphicsView->setRenderHint(QPainter::Antialiasing);
     ui->graphicsView->setRenderHint(QPainter::TextAntialiasing);
     ui->graphicsView->setDragMode(QGraphicsView::ScrollHandDrag);
+    SIM_COUNT(profile, "elementos_escena", added);
+}
+
+// Área de los ciclos [start, end) en una fila; cubre también el espacio entre columnas
+QRectF SynchronizationWindow::segmentArea(int start, int end, int row) const
+{
+    int y = START_Y + row * (BLOCK_HEIGHT + VERTICAL_SPACING);
+    return QRectF(columnX(start), y, columnX(end - 1) + BLOCK_WIDTH - columnX(start), BLOCK_HEIGHT);
+}
+
+// Un tramo de retención o de espera, recortado a `upToCycle`; los textos son hijos del
+// rectángulo. Devuelve cuántos elementos agregó a la escena.
+int SynchronizationWindow::drawSegment(const Timeline::Segment &segment, int row, bool holding, int upToCycle)
+{
+    const Action &action = timelineActions[segment.owner];
+    const int shownEnd = std::min(segment.end(), upToCycle + 1);
+    QRectF area = segmentArea(segment.start, shownEnd, row);
+
+    QColor color = holding ? QColor(144, 238, 144) : QColor(255, 165, 0);
+    QGraphicsRectItem *rect = scene->addRect(area, QPen(Qt::black), QBrush(color));
+    QString status = QString("%1 %2-%3").arg(holding ? "HOLDING" : "WAITING").arg(segment.start).arg(segment.end() - 1);
+    const QString lines[] = {QString("%1 - %2").arg(action.PID).arg(action.resource), action.action, status};
+    for (int i = 0; i < 3; ++i) {
+        QGraphicsTextItem *text = new QGraphicsTextItem(lines[i], rect);
+        text->setPos(area.x() + 5, area.y() + 5 + 20 * i);
+    }
+    if (holding && action.realWaitCycles >= 0) {
+        rect->setToolTip(QString("Espera simulada: %1 ciclos\nEspera con hilos reales: %2 ciclos")
+                             .arg(action.completionCycle - action.cycle)
+                             .arg(action.realWaitCycles, 0, 'f', 2));
+    }
+    if (segment.end() > shownEnd) clippedSegments.append({segment.start, segment.end(), row, rect});
+
+    int added = 4;
+    if (!labeledCycles.contains(segment.start)) {
+        labeledCycles.insert(segment.start);
+        QGraphicsTextItem *cycleText = scene->addText(QString::number(segment.start));
+        cycleText->setPos(columnX(segment.start) + BLOCK_WIDTH / 2 - 10, START_Y - 30);
+        added++;
+    }
+    return added;
 }
 
 void SynchronizationWindow::showNextCycle()
@@ -461,248 +990,104 @@ void SynchronizationWindow::showNextCycle()
     drawAccumulatedCycles(displayCycle);
 }
 
-void SynchronizationWindow::drawSingleCycle(int cycleToDraw)
+// Mover el control salta a ese ciclo; si la reproducción seguía, continúa desde ahí
+void SynchronizationWindow::onCycleSliderChanged(int cycle)
 {
-    scene->clear();
-
-    const int blockWidth = 100;
-    const int blockHeight = 70;
-    const int verticalSpacing = 15;
-    const int horizontalSpacing = 30;
-    const int startX = 20;
-    const int startY = 50;
-
-    // Dibujar encabezados de todos los ciclos (para referencia)
-    for (int cycle = 0; cycle < cycleStates.size(); cycle++) {
-        QGraphicsTextItem *cycleText = scene->addText(QString::number(cycle));
-        cycleText->setPos(startX + cycle * (blockWidth + horizontalSpacing) + blockWidth/2 - 10, startY - 30);
-
-        // Resaltar el ciclo actual
-        if (cycle == cycleToDraw) {
-            QGraphicsRectItem *highlight = scene->addRect(
-                startX + cycle * (blockWidth + horizontalSpacing) - 5, startY - 35,
-                blockWidth + 10, 25,
-                QPen(Qt::red, 2), Qt::NoBrush);
-        }
-    }
-
-    const CycleState &state = cycleStates[cycleToDraw];
-    int verticalOffset = 0;
-
-    // Dibujar acciones accedidas en este ciclo
-    for (const Action &action : state.accessedActions) {
-        int x = startX + cycleToDraw * (blockWidth + horizontalSpacing);
-        int y = startY + verticalOffset;
-
-        QGraphicsRectItem *rect = scene->addRect(x, y, blockWidth, blockHeight,
-                                                 QPen(Qt::black), QBrush(Qt::green));
-
-        QGraphicsTextItem *pidText = scene->addText(QString("%1 - %2").arg(action.PID).arg(action.resource));
-        pidText->setPos(x + 5, y + 5);
-
-        QGraphicsTextItem *actionText = scene->addText(action.action);
-        actionText->setPos(x + 5, y + 25);
-
-        QGraphicsTextItem *statusText = scene->addText("ACCESSED");
-        statusText->setPos(x + 5, y + 45);
-
-        verticalOffset += blockHeight + verticalSpacing;
-    }
-
-    // Dibujar acciones en espera en este ciclo
-    for (const Action &action : state.waitingActions) {
-        int x = startX + cycleToDraw * (blockWidth + horizontalSpacing);
-        int y = startY + verticalOffset;
-
-        QGraphicsRectItem *rect = scene->addRect(x, y, blockWidth, blockHeight,
-                                                 QPen(Qt::black), QBrush(QColor(255, 165, 0)));
-
-        QGraphicsTextItem *pidText = scene->addText(QString("%1 - %2").arg(action.PID).arg(action.resource));
-        pidText->setPos(x + 5, y + 5);
-
-        QGraphicsTextItem *actionText = scene->addText(action.action);
-        actionText->setPos(x + 5, y + 25);
-
-        QGraphicsTextItem *statusText = scene->addText("WAITING");
-        statusText->setPos(x + 5, y + 45);
-
-        verticalOffset += blockHeight + verticalSpacing;
-    }
-
-    ui->graphicsView->fitInView(scene->sceneRect(), Qt::KeepAspectRatio);
+    if (timeline.isEmpty()) return;
+    displayCycle = std::min(cycle, currentCycle);
+    drawAccumulatedCycles(displayCycle);
 }
 
-void SynchronizationWindow::drawCompleteTimeline()
+void SynchronizationWindow::startReplay()
 {
-    scene->clear();
-
-    const int blockWidth = 100;
-    const int blockHeight = 70;
-    const int verticalSpacing = 15;
-    const int horizontalSpacing = 30;
-    const int startX = 20;
-    const int startY = 50;
-
-    // Dibujar encabezados de ciclo
-    for (int cycle = 0; cycle < cycleStates.size(); cycle++) {
-        QGraphicsTextItem *cycleText = scene->addText(QString::number(cycle));
-        cycleText->setPos(startX + cycle * (blockWidth + horizontalSpacing) + blockWidth/2 - 10, startY - 30);
+    replay = SyncReplay(timeline);
+    clearTimelineScene();
+    {
+        QSignalBlocker blocker(ui->sliderCycle);
+        ui->sliderCycle->setRange(0, currentCycle);
+        ui->sliderCycle->setValue(0);
     }
+    ui->sliderCycle->setEnabled(true);
 
-    // Dibujar cada ciclo
-    for (int cycle = 0; cycle < cycleStates.size(); cycle++) {
-        const CycleState &state = cycleStates[cycle];
-        int verticalOffset = 0;
-
-        // Dibujar acciones accedidas en este ciclo
-        for (const Action &action : state.accessedActions) {
-            int x = startX + cycle * (blockWidth + horizontalSpacing);
-            int y = startY + verticalOffset;
-
-            QGraphicsRectItem *rect = scene->addRect(x, y, blockWidth, blockHeight,
-                                                     QPen(Qt::black), QBrush(Qt::green));
-
-            QGraphicsTextItem *pidText = scene->addText(QString("%1 - %2").arg(action.PID).arg(action.resource));
-            pidText->setPos(x + 5, y + 5);
-
-            QGraphicsTextItem *actionText = scene->addText(action.action);
-            actionText->setPos(x + 5, y + 25);
-
-            QGraphicsTextItem *statusText = scene->addText("ACCESSED");
-            statusText->setPos(x + 5, y + 45);
-
-            verticalOffset += blockHeight + verticalSpacing;
-        }
-
-        // Dibujar acciones en espera en este ciclo
-        for (const Action &action : state.waitingActions) {
-            int x = startX + cycle * (blockWidth + horizontalSpacing);
-            int y = startY + verticalOffset;
-
-            QGraphicsRectItem *rect = scene->addRect(x, y, blockWidth, blockHeight,
-                                                     QPen(Qt::black), QBrush(QColor(255, 165, 0)));
-
-            QGraphicsTextItem *pidText = scene->addText(QString("%1 - %2").arg(action.PID).arg(action.resource));
-            pidText->setPos(x + 5, y + 5);
-
-            QGraphicsTextItem *actionText = scene->addText(action.action);
-            actionText->setPos(x + 5, y + 25);
-
-            QGraphicsTextItem *statusText = scene->addText("WAITING");
-            statusText->setPos(x + 5, y + 45);
+    // Iniciar la visualización paso a paso
+    displayCycle = -1;
+    displayTimer->start(1000);
+}
 
-            verticalOffset += blockHeight + verticalSpacing;
-        }
+void SynchronizationWindow::drawRun(const SyncRunResult &result)
+{
+    resetSimulation();
+    actions = result.actions;
+    currentCycle = result.finalCycle;
+    timelineActions = actions;
+    timeline = buildSyncTimeline(actions, currentCycle);
+    replay = SyncReplay(timeline);
+    {
+        QSignalBlocker blocker(ui->sliderCycle);
+        ui->sliderCycle->setRange(0, currentCycle);
     }
-
-    ui->graphicsView->fitInView(scene->sceneRect(), Qt::KeepAspectRatio);
+    drawAccumulatedCycles(currentCycle);
 }
 
-void SynchronizationWindow::drawTimeline()
+void SynchronizationWindow::clearTimelineScene()
 {
     scene->clear();
+    drawnCycle = -1;
+    clippedSegments.clear();
+    labeledCycles.clear();
+    cycleHighlight = nullptr;
+    cycleStatus = nullptr;
+}
 
-    const int blockWidth = 100;
-    const int blockHeight = 70;
-    const int verticalSpacing = 15;
-    const int horizontalSpacing = 30;
-    const int startX = 20;
-    const int startY = 50;
-
-    for (int cycle = 0; cycle <= currentCycle; cycle++) {
-        QGraphicsTextItem *cycleText = scene->addText(QString::number(cycle));
-        cycleText->setPos(startX + cycle * (blockWidth + horizontalSpacing) + blockWidth/2 - 10, startY - 30);
-    }
-
-    for (int cycle = 0; cycle <= currentCycle; cycle++) {
-        int verticalOffset = 0;
-
-        for (Action &action : actions) {
-            if (action.completed && action.completionCycle == cycle) {
-                int x = startX + cycle * (blockWidth + horizontalSpacing);
-                int y = startY + verticalOffset;
-
-                QGraphicsRectItem *rect = scene->addRect(x, y, blockWidth, blockHeight,
-                                                         QPen(Qt::black), QBrush(Qt::green));
-
-                QGraphicsTextItem *pidText = scene->addText(QString("%1 - %2").arg(action.PID).arg(action.resource));
-                pidText->setPos(x + 5, y + 5);
-
-                QGraphicsTextItem *actionText = scene->addText(action.action);
-                actionText->setPos(x + 5, y + 25);
-
-                QGraphicsTextItem *statusText = scene->addText("ACCESSED");
-                statusText->setPos(x + 5, y + 45);
-
-                verticalOffset += blockHeight + verticalSpacing;
-            }
-        }
-
-        for (Action &action : actions) {
-            if (action.waitingSince == cycle ||
-                (action.waitingSince < cycle && !action.completed)) {
-                int x = startX + cycle * (blockWidth + horizontalSpacing);
-                int y = startY + verticalOffset;
-
-                QGraphicsRectItem *rect = scene->addRect(x, y, blockWidth, blockHeight,
-                                                         QPen(Qt::black), QBrush(QColor(255, 165, 0)));
-
-                QGraphicsTextItem *pidText = scene->addText(QString("%1 - %2").arg(action.PID).arg(action.resource));
-                pidText->setPos(x + 5, y + 5);
-
-                QGraphicsTextItem *actionText = scene->addText(action.action);
-                actionText->setPos(x + 5, y + 25);
-
-                QGraphicsTextItem *statusText = scene->addText("WAITING");
-                statusText->setPos(x + 5, y + 45);
-
-                verticalOffset += blockHeight + verticalSpacing;
-            }
-        }
+void SynchronizationWindow::onDiagnosticsClicked()
+{
+    if (!diagnostics) {
+        diagnostics = new DiagnosticsDialog(profile, "sincronizacion", this);
     }
+    diagnostics->show();
+    diagnostics->raise();
+    diagnostics->refresh();
+}
 
-    ui->graphicsView->fitInView(scene->sceneRect(), Qt::KeepAspectRatio);
+void SynchronizationWindow::logMessage(const QString &message, LogLevel level)
+{
+    // Se acumula en el búfer; logFlusher lo vuelca al registro en lotes
+    logger.log(level, message);
 }
 
-void SynchronizationWindow::logMessage(const QString &message)
+void SynchronizationWindow::onLogLevelChanged(int index)
 {
-    ui->txtLog->append(message);
-    qDebug() << message;
+    static const LogLevel levels[] = {LogLevel::Debug, LogLevel::Info, LogLevel::Error, LogLevel::Off};
+    logger.setLevel(levels[std::clamp(index, 0, 3)]);
 }
 
 void SynchronizationWindow::resetSimulation()
 {
+    runGeneration++;
+    timelineActions.clear();
+    scriptShown = false;
     simulationTimer->stop();
-    scene->clear();
-    currentCycle = 0;
+    clearTimelineScene();
     simulationRunning = false;
-    cycleStates.clear(); // Limpiar estados anteriores
+    engine.reset();
+    currentCycle = 0;
+    timeline = SyncTimeline(); // Limpiar la corrida anterior
+    hasMetrics = false;
+    ui->tblMetrics->setRowCount(0);
+    ui->btnExportMetrics->setEnabled(false);
 
     for (Action &a : actions) {
         a.completed = false;
         a.completionCycle = -1;
         a.waitingSince = -1;
-    }
-
-    for (auto it = waitingQueues.begin(); it != waitingQueues.end(); ++it) {
-        while (!it.value().empty()) {
-            it.value().pop();
-        }
-    }
-
-    for (auto it = resourceInUse.begin(); it != resourceInUse.end(); ++it) {
-        it.value() = false;
-    }
-
-    if (useSemaphore) {
-        for (auto it = semaphoreCounts.begin(); it != semaphoreCounts.end(); ++it) {
-            it.value() = 1;
-        }
+        a.realWaitCycles = -1;
     }
 
     displayTimer->stop();
     displayCycle = -1;
-    cycleStates.clear();
+    replay = SyncReplay();
+    ui->sliderCycle->setEnabled(false);
+    ui->lblCycle->setText("0 / 0");
 }
 
 QColor SynchronizationWindow::getProcessColor(const QString &pid)
@@ -5,28 +5,25 @@
 #include <QGraphicsScene>
 #include <QVector>
 #include <QMap>
+#include <QSet>
 #include <QTimer>
-#include <queue>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include "syncengine.h"
+#include "syncmetrics.h"
+#include "syncplanner.h"
+#include "simlogger.h"
+#include "siminstrumentation.h"
+#include "fileloader.h"
+#include "realthreadrunner.h"
+
+class DiagnosticsDialog;
 
 namespace Ui {
 class SynchronizationWindow;
 }
 
-struct Action {
-    QString PID;
-    QString action;
-    QString resource;
-    int cycle;
-    bool completed;
-    int completionCycle;
-    int waitingSince;
-};
-
-struct CycleState {
-    QVector<Action> accessedActions;
-    QVector<Action> waitingActions;
-};
-
 class SynchronizationWindow : public QMainWindow
 {
     Q_OBJECT
@@ -35,45 +32,93 @@ public:
     explicit SynchronizationWindow(QWidget *parent = nullptr);
     ~SynchronizationWindow();
 
+    // Dibuja todos los ciclos de una corrida de una vez, sin registro, métricas ni
+    // reproducción; lo usa el benchmark de renderizado
+    void drawRun(const SyncRunResult &result);
+
 private slots:
     void onLoadResourcesClicked();
     void onLoadActionsClicked();
     void onRunSimulationClicked();
     void runSimulationStep();
     void onSyncTypeChanged(int index);
+    void onRwPolicyChanged(int index);
     void showNextCycle();
+    void onCycleSliderChanged(int cycle);
+    void onRunRealThreadsClicked();
+    void onPlanCapacityClicked();
+    void onExportMetricsClicked();
+    void onLogLevelChanged(int index);
+    void onRunScriptClicked();
+    void onDiagnosticsClicked();
 
 private:
     Ui::SynchronizationWindow *ui;
     QGraphicsScene *scene;
+    SimLogger logger;
+    LogFlusher *logFlusher;
+    FileLoader *loader;     // Lectura y parseo de archivos fuera del hilo de la interfaz
+    SimProfile profile;     // Tiempos por fase y contadores de la ventana
+    DiagnosticsDialog *diagnostics = nullptr;
     QVector<Action> actions;
     QMap<QString, QColor> processColors;
-    QMap<QString, bool> resourceInUse;
-    QMap<QString, int> semaphoreCounts;
-    QMap<QString, std::queue<Action*>> waitingQueues;
+    QMap<QString, int> semaphoreCapacity;
+    QMap<QString, WakeupPolicy> resourcePolicies;
+    std::unique_ptr<SyncEngine> engine;
     QTimer *simulationTimer;
     int currentCycle;
     int maxCycles;
     bool useSemaphore;
+    bool useReaderWriter;
+    RwPolicy rwPolicy;
     bool simulationRunning;
-    QVector<CycleState> cycleStates;
-    void drawCompleteTimeline();
-    void storeCurrentCycleState();
+    SyncTimeline timeline;      // Lo que se dibuja; se arma al terminar cada corrida
+    QVector<Action> timelineActions;    // Acciones de `timeline`: las simuladas o las adquisiciones de un guion
+    bool scriptShown = false;           // La línea de tiempo es de un guion, no de `actions`
+    SyncReplay replay;          // Estado de cualquier ciclo de `timeline` sin recorrerla entera
+    // Tramo de `timeline` que la reproducción todavía no muestra entero; su rectángulo se
+    // alarga a medida que avanza el ciclo mostrado
+    struct ClippedSegment {
+        int start;
+        int end;
+        int row;
+        QGraphicsRectItem *rect;
+    };
+    int drawnCycle = -1;                        // Último ciclo dibujado
+    QVector<ClippedSegment> clippedSegments;
+    QSet<int> labeledCycles;                    // Ciclos con número en el encabezado
+    QGraphicsRectItem *cycleHighlight = nullptr;
+    QGraphicsTextItem *cycleStatus = nullptr;   // Cuántas acciones retienen y esperan en el ciclo mostrado
+    std::thread realThreadWorker;   // Corrida con hilos reales; el reporte vuelve por la cola de eventos
+    bool realThreadsRunning = false;
+    std::atomic<bool> stopRealThreads{false};   // Corta la corrida con hilos reales al cerrar la ventana
+    int runGeneration = 0;          // Cambia con cada reinicio; descarta reportes de corridas viejas
+    std::thread plannerWorker;      // Planificación de permisos; el resultado vuelve por la cola de eventos
+    bool planning = false;
+    SyncMetrics lastMetrics;
+    bool hasMetrics;
     void parseResourceFile(const QString &content);
-    void parseActionFile(const QString &content);
-    void prepareSimulation();
-    void drawTimeline();
-    void logMessage(const QString &message);
+    void indexActions();
+    void logMessage(const QString &message, LogLevel level = LogLevel::Info);
+    void logEvent(const SyncEvent &event, const QVector<Action> &source);
     void resetSimulation();
-    bool waitingQueuesEmpty() const;
+    void showRealThreadReport(const RealThreadReport &report, int generation, int cycleUs);
+    void showCapacityPlan(const PlannerResult &plan, const PlannerRequest &request, qint64 elapsedMs, int generation);
+    void finishSimulation(const SyncRunResult &result);
+    SyncConfig currentConfig() const;
+    SimulationSummary runHeadless(const SyncConfig &config);
+    void logPolicyComparison();
+    void logReaderWriterComparison();
+    void showMetrics(const SyncMetrics &metrics);
+    QString modeName() const;
     QColor getProcessColor(const QString &pid);
-    void processWaitingActions();
-    bool tryAccessResource(Action* action);
-    void releaseResource(const QString &resource);
     int displayCycle;
     QTimer *displayTimer;
-    void drawSingleCycle(int cycleToDraw);
     void drawAccumulatedCycles(int upToCycle);
+    int drawSegment(const Timeline::Segment &segment, int row, bool holding, int upToCycle);
+    QRectF segmentArea(int start, int end, int row) const;
+    void startReplay();
+    void clearTimelineScene();
 };
 
 #endif // SYNCHRONIZATIONWINDOW_H
@@ -0,0 +1,130 @@
+#include "syncmetrics.h"
+#include "schedulemetrics.h"
+#include <QTextStream>
+#include <algorithm>
+
+namespace {
+
+// Acumuladores de un recurso mientras se recorren las acciones
+struct ResourceAccumulator {
+    QVector<int> waits;
+    QVector<int> queueDelta;    // +1 al entrar a la cola, -1 al salir
+    QVector<int> heldDelta;     // +1 al obtener el recurso, -1 al liberarlo
+    int pending = 0;
+};
+
+// Ordena `waits` para sacar los percentiles
+void fillWaitStats(ResourceMetrics &metrics, QVector<int> &waits)
+{
+    metrics.accesses = waits.size();
+    if (waits.isEmpty()) return;
+
+    std::sort(waits.begin(), waits.end());
+    long long total = 0;
+    for (int wait : waits) total += wait;
+    metrics.maxWait = waits.last();
+    metrics.meanWait = double(total) / waits.size();
+    metrics.p95Wait = sortedPercentile(waits, 95);
+    metrics.p99Wait = sortedPercentile(waits, 99);
+}
+
+}
+
+SyncMetrics computeSyncMetrics(const QVector<Action> &results, int finalCycle, const QMap<QString, int> &capacity)
+{
+    SyncMetrics metrics;
+    metrics.totalCycles = finalCycle + 1;
+    const int horizon = metrics.totalCycles;
+
+    QMap<QString, ResourceAccumulator> accumulators;
+    QVector<int> allWaits;
+    allWaits.reserve(results.size());
+
+    for (const Action &action : results) {
+        ResourceAccumulator &acc = accumulators[action.resource];
+        if (acc.queueDelta.isEmpty()) {
+            acc.queueDelta.resize(horizon + 1);
+            acc.heldDelta.resize(horizon + 1);
+        }
+
+        int blockedUntil = action.completed ? action.completionCycle : horizon;
+        metrics.blockedCycles[action.PID] += std::max(0, blockedUntil - action.cycle);
+
+        if (action.waitingSince != -1) {
+            acc.queueDelta[std::clamp(action.waitingSince, 0, horizon)]++;
+            acc.queueDelta[std::clamp(blockedUntil, 0, horizon)]--;
+        }
+
+        if (action.completed) {
+            int wait = action.completionCycle - action.cycle;
+            acc.waits.append(wait);
+            allWaits.append(wait);
+            acc.heldDelta[std::clamp(action.completionCycle, 0, horizon)]++;
+            acc.heldDelta[std::clamp(action.completionCycle + action.holdCycles, 0, horizon)]--;
+        } else {
+            acc.pending++;
+            metrics.overall.pending++;
+        }
+    }
+
+    for (auto it = accumulators.begin(); it != accumulators.end(); ++it) {
+        ResourceAccumulator &acc = it.value();
+        ResourceMetrics resource;
+        resource.pending = acc.pending;
+        fillWaitStats(resource, acc.waits);
+        resource.throughput = double(resource.accesses) / horizon;
+
+        // Barrido de prefijos: ocupación y profundidad de cola por ciclo
+        const int permits = std::max(1, capacity.value(it.key(), 1));
+        int queued = 0;
+        int held = 0;
+        long long usedPermitCycles = 0;
+        for (int cycle = 0; cycle < horizon; ++cycle) {
+            queued += acc.queueDelta[cycle];
+            held += acc.heldDelta[cycle];
+            resource.maxQueueDepth = std::max(resource.maxQueueDepth, queued);
+            // Lectores simultáneos cuentan como un recurso ocupado, no como varios permisos
+            usedPermitCycles += std::min(held, permits);
+        }
+        resource.utilization = double(usedPermitCycles) / (double(permits) * horizon);
+
+        metrics.resources.insert(it.key(), resource);
+        metrics.overall.maxQueueDepth = std::max(metrics.overall.maxQueueDepth, resource.maxQueueDepth);
+        metrics.overall.utilization += resource.utilization;
+    }
+
+    fillWaitStats(metrics.overall, allWaits);
+    metrics.overall.throughput = double(metrics.overall.accesses) / horizon;
+    if (!metrics.resources.isEmpty()) {
+        metrics.overall.utilization /= metrics.resources.size();
+    }
+    return metrics;
+}
+
+QString formatMetricsCsv(const SyncMetrics &metrics, const QString &modeName)
+{
+    QString content;
+    QTextStream out(&content);
+    out << "modo,recurso,accesos,pendientes,utilizacion,espera_media,espera_p95,espera_p99,"
+           "espera_max,cola_max,accesos_por_ciclo\n";
+
+    auto writeRow = [&](const QString &name, const ResourceMetrics &r) {
+        out << modeName << "," << name << "," << r.accesses << "," << r.pending << ","
+            << QString::number(r.utilization, 'f', 4) << ","
+            << QString::number(r.meanWait, 'f', 2) << ","
+            << r.p95Wait << "," << r.p99Wait << "," << r.maxWait << ","
+            << r.maxQueueDepth << ","
+            << QString::number(r.throughput, 'f', 4) << "\n";
+    };
+    for (auto it = metrics.resources.begin(); it != metrics.resources.end(); ++it) {
+        writeRow(it.key(), it.value());
+    }
+    writeRow("TOTAL", metrics.overall);
+
+    out << "\nmodo,proceso,ciclos_bloqueado\n";
+    for (auto it = metrics.blockedCycles.begin(); it != metrics.blockedCycles.end(); ++it) {
+        out << modeName << "," << it.key() << "," << it.value() << "\n";
+    }
+    out.flush();
+    return content;
+}
@@ -0,0 +1,39 @@
+#ifndef SYNCMETRICS_H
+#define SYNCMETRICS_H
+
+#include <QString>
+#include <QVector>
+#include <QMap>
+#include "syncengine.h"
+
+// Métricas de un recurso en una corrida
+struct ResourceMetrics {
+    int accesses = 0;           // Accesos concedidos
+    int pending = 0;            // Acciones que nunca obtuvieron el recurso
+    double utilization = 0.0;   // Fracción de permisos ocupados sobre todos los ciclos
+    double meanWait = 0.0;      // Espera en ciclos desde la llegada hasta el acceso
+    int p95Wait = 0;
+    int p99Wait = 0;
+    int maxWait = 0;
+    int maxQueueDepth = 0;      // Máximo de acciones en espera a la vez
+    double throughput = 0.0;    // Accesos concedidos por ciclo
+};
+
+// Métricas numéricas de una corrida de sincronización
+struct SyncMetrics {
+    int totalCycles = 0;
+    QMap<QString, ResourceMetrics> resources;
+    QMap<QString, int> blockedCycles;   // Ciclos bloqueados por proceso
+    ResourceMetrics overall;            // Todas las acciones juntas
+};
+
+// Calcula las métricas en una sola pasada sobre las acciones simuladas. La profundidad de
+// cola y la ocupación usan arreglos de diferencias por recurso, así que el costo es lineal
+// en acciones más ciclos. `capacity` da los permisos por recurso (1 si no aparece).
+SyncMetrics computeSyncMetrics(const QVector<Action> &results, int finalCycle,
+                               const QMap<QString, int> &capacity = {});
+
+// Exporta las métricas como CSV, una fila por recurso y una por proceso
+QString formatMetricsCsv(const SyncMetrics &metrics, const QString &modeName);
+
+#endif // SYNCMETRICS_H
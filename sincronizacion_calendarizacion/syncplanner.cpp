@@ -0,0 +1,126 @@
+#include "syncplanner.h"
+#include "parallel.h"
+#include "syncmetrics.h"
+#include <QTextStream>
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Espera de la corrida según el objetivo; INT_MAX si alguna acción nunca obtuvo el recurso
+int measureWait(const SyncRunResult &run, PlannerTarget target)
+{
+    SyncMetrics metrics = computeSyncMetrics(run.actions, run.finalCycle);
+    if (metrics.overall.pending > 0) return INT_MAX;
+    return target == PlannerTarget::MaxWait ? metrics.overall.maxWait : metrics.overall.p99Wait;
+}
+
+int simulateWait(const QVector<Action> &shard, const SyncConfig &base, const QString &resource,
+                 int permits, PlannerTarget target)
+{
+    SyncConfig config = base;
+    config.mode = SyncMode::Semaphore;
+    config.capacity.clear();
+    config.capacity[resource] = permits;
+
+    SyncEngine engine(config, false);
+    engine.load(shard);
+    return measureWait(engine.runToCompletion(), target);
+}
+
+}
+
+PlannerResult planSemaphoreCapacity(const QVector<Action> &actions, const PlannerRequest &request, int threads)
+{
+    if (threads <= 0) threads = int(std::max(1u, std::thread::hardware_concurrency()));
+
+    QMap<QString, QVector<Action>> shards;
+    for (const Action &action : actions) {
+        shards[action.resource].append(action);
+    }
+
+    // Contenedores fijos antes de lanzar hilos: solo se leen o se escriben por índice
+    const QStringList resources = shards.keys();
+    std::vector<int> bestPermits(resources.size(), 1);
+    std::vector<int> bestWait(resources.size(), 0);
+    std::atomic<int> simulations{0};
+
+    // Búsqueda k-aria sobre [1, n]: con n permisos (una por acción) nadie espera
+    auto searchResource = [&](int r, int innerThreads) {
+        const QString resource = resources.at(r);
+        const QVector<Action> shard = shards.value(resource);
+        int low = 1;
+        int high = std::max(1, int(shard.size()));
+        int highWait = simulateWait(shard, request.base, resource, high, request.target);
+        simulations++;
+
+        while (low < high) {
+            // Candidatos interiores repartidos en [low, high); con un hilo es búsqueda binaria
+            int span = high - low;
+            int count = std::min(innerThreads, span);
+            std::vector<int> candidates(count);
+            for (int i = 0; i < count; ++i) {
+                candidates[i] = low + (span * (i + 1)) / (count + 1);
+            }
+            std::vector<int> waits(count);
+            parallelFor(count, [&](int i) {
+                waits[i] = simulateWait(shard, request.base, resource, candidates[i], request.target);
+            }, innerThreads);
+            simulations += count;
+
+            // Por monotonía, el primer candidato que cumple acota el intervalo por arriba
+            int firstMeeting = count;
+            for (int i = 0; i < count; ++i) {
+                if (waits[i] <= request.targetCycles) {
+                    firstMeeting = i;
+                    break;
+                }
+            }
+
+            if (firstMeeting < count) {
+                high = candidates[firstMeeting];
+                highWait = waits[firstMeeting];
+                low = firstMeeting > 0 ? candidates[firstMeeting - 1] + 1 : low;
+            } else {
+                low = candidates[count - 1] + 1;
+            }
+        }
+
+        bestPermits[r] = high;
+        bestWait[r] = highWait;
+    };
+
+    if (resources.size() >= threads) {
+        parallelFor(resources.size(), [&](int r) { searchResource(r, 1); }, threads);
+    } else {
+        for (int r = 0; r < resources.size(); ++r) {
+            searchResource(r, threads);
+        }
+    }
+
+    PlannerResult result;
+    for (int r = 0; r < resources.size(); ++r) {
+        result.permits[resources.at(r)] = bestPermits[r];
+        result.achievedWait[resources.at(r)] = bestWait[r];
+    }
+    result.simulations = simulations;
+    return result;
+}
+
+QString formatResourceFile(const PlannerResult &plan, const QMap<QString, WakeupPolicy> &policies)
+{
+    QString content;
+    QTextStream out(&content);
+    for (auto it = plan.permits.begin(); it != plan.permits.end(); ++it) {
+        out << it.key() << ", " << it.value();
+        if (policies.contains(it.key())) {
+            out << ", " << (policies.value(it.key()) == WakeupPolicy::WakeAll ? "ALL" : "ONE");
+        }
+        out << "\n";
+    }
+    out.flush();
+    return content;
+}
@@ -0,0 +1,37 @@
+#ifndef SYNCPLANNER_H
+#define SYNCPLANNER_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QMap>
+#include "syncengine.h"
+
+// Métrica de espera que debe cumplir cada recurso
+enum class PlannerTarget {
+    MaxWait,    // Espera máxima en ciclos
+    P99Wait     // Percentil 99 de la espera en ciclos
+};
+
+struct PlannerRequest {
+    SyncConfig base;            // Políticas de despertar; el modo se fuerza a semáforo
+    PlannerTarget target = PlannerTarget::MaxWait;
+    int targetCycles = 0;
+};
+
+struct PlannerResult {
+    QMap<QString, int> permits;         // Mínimo de permisos por recurso que cumple el objetivo
+    QMap<QString, int> achievedWait;    // Espera obtenida con esos permisos
+    int simulations = 0;                // Corridas evaluadas en total
+};
+
+// Busca, para cada recurso, el menor contador de semáforo que cumple el objetivo de espera.
+// La espera nunca crece al aumentar los permisos, así que basta una búsqueda binaria por
+// recurso. Los recursos no interactúan: se planifican en paralelo, y cuando hay menos
+// recursos que hilos se evalúan varios candidatos del mismo recurso a la vez.
+PlannerResult planSemaphoreCapacity(const QVector<Action> &actions, const PlannerRequest &request, int threads = 0);
+
+// Genera el contenido de un archivo de recursos con los permisos planificados
+QString formatResourceFile(const PlannerResult &plan, const QMap<QString, WakeupPolicy> &policies);
+
+#endif // SYNCPLANNER_H
@@ -0,0 +1,103 @@
+#include "timeline.h"
+
+int Timeline::intern(const QString &name)
+{
+    auto found = ownerIndex.find(name);
+    if (found != ownerIndex.end()) return found.value();
+    int owner = names.size();
+    names.append(name);
+    ownerIndex.insert(name, owner);
+    return owner;
+}
+
+void Timeline::append(int owner, int start, int length)
+{
+    if (length <= 0 || owner < 0) return;
+    busy += length;
+    if (open.length > 0 && open.owner == owner && open.end() == start) {
+        open.length += length;
+        return;
+    }
+    if (open.length > 0) encode(open);
+    open.owner = owner;
+    open.start = start;
+    open.length = length;
+}
+
+void Timeline::encode(const Segment &segment)
+{
+    if (encoded % BLOCK_SIZE == 0) {
+        blocks.append({segment.start, int(bytes.size())});
+        writeVarint(bytes, 0);
+    } else {
+        writeVarint(bytes, unsigned(segment.start - encodedEnd));
+    }
+    writeVarint(bytes, unsigned(segment.length));
+    writeVarint(bytes, unsigned(segment.owner));
+    encoded++;
+    encodedEnd = segment.end();
+}
+
+int Timeline::end() const
+{
+    return open.length > 0 ? open.end() : encodedEnd;
+}
+
+int Timeline::memoryBytes() const
+{
+    return int(bytes.size() + blocks.size() * sizeof(Block));
+}
+
+int Timeline::blockFor(int time) const
+{
+    auto after = std::upper_bound(blocks.begin(), blocks.end(), time,
+                                  [](int t, const Block &block) { return t < block.start; });
+    return int(after - blocks.begin()) - 1;
+}
+
+Timeline::Segment Timeline::at(int index) const
+{
+    if (index == encoded && open.length > 0) return open;
+    Segment found;
+    if (index < 0 || index >= encoded) return found;
+    walk(index / BLOCK_SIZE, [&](int i, const Segment &segment) {
+        if (i < index) return true;
+        found = segment;
+        return false;
+    });
+    return found;
+}
+
+int Timeline::indexAt(int time) const
+{
+    if (open.length > 0 && time >= open.start) return time < open.end() ? encoded : -1;
+    int result = -1;
+    walk(blockFor(time), [&](int i, const Segment &segment) {
+        if (segment.start > time) return false;
+        if (time < segment.end()) {
+            result = i;
+            return false;
+        }
+        return true;
+    });
+    return result;
+}
+
+Timeline::Segment Timeline::segmentAt(int time) const
+{
+    int index = indexAt(time);
+    if (index == -1) {
+        Segment idle;
+        idle.start = time;
+        idle.length = 1;
+        return idle;
+    }
+    return at(index);
+}
+
+QVector<Timeline::Segment> Timeline::range(int from, int to) const
+{
+    QVector<Segment> segments;
+    forEach(from, to, [&segments](const Segment &segment) { segments.append(segment); });
+    return segments;
+}
@@ -0,0 +1,138 @@
+#ifndef TIMELINE_H
+#define TIMELINE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <algorithm>
+#include <climits>
+
+// Línea de tiempo compacta de un carril: tramos [start, start + length) en orden y sin
+// solape, cada uno con un dueño (índice de proceso o de acción). Cada tramo se guarda como
+// varints de (hueco desde el fin del anterior, duración, dueño), en bloques de BLOCK_SIZE
+// tramos que recuerdan su inicio absoluto; un tramo típico ocupa 3 o 4 bytes. Saber qué
+// corría en el ciclo t es una búsqueda binaria sobre los bloques y un recorrido dentro de uno.
+// La copia es barata: los datos se comparten hasta que alguna copia se modifica.
+class Timeline
+{
+public:
+    struct Segment {
+        int owner = -1;     // -1 si en ese momento no corre nada
+        int start = 0;
+        int length = 0;
+        int end() const { return start + length; }
+    };
+
+    // Dueños con nombre (el PID en el Gantt); el mismo nombre da el mismo índice
+    int intern(const QString &name);
+    int find(const QString &name) const { return ownerIndex.value(name, -1); }
+    QString name(int owner) const { return owner >= 0 && owner < names.size() ? names[owner] : QString(); }
+    int ownerCount() const { return names.size(); }
+
+    // Agrega un tramo que empieza en o después del fin del último; si lo continúa con el
+    // mismo dueño lo extiende en vez de crear otro
+    void append(int owner, int start, int length);
+    void append(const QString &name, int start, int length) { append(intern(name), start, length); }
+
+    int size() const { return encoded + (open.length > 0 ? 1 : 0); }
+    bool isEmpty() const { return size() == 0; }
+    int end() const;                    // Fin del último tramo, 0 si está vacía
+    int busyTime() const { return busy; }
+    int memoryBytes() const;            // Lo que ocupan los tramos codificados y los bloques
+
+    Segment at(int index) const;        // Tramo por posición
+    int indexAt(int time) const;        // Posición del tramo que contiene `time`, -1 si nada
+    Segment segmentAt(int time) const;  // Tramo que contiene `time`; owner -1 si nada
+
+    // fn(const Segment &) para cada tramo que se cruza con [from, to), en orden
+    template <typename F>
+    void forEach(int from, int to, F fn) const;
+    template <typename F>
+    void forEach(F fn) const { forEach(INT_MIN, INT_MAX, fn); }
+    QVector<Segment> range(int from, int to) const;
+
+private:
+    static const int BLOCK_SIZE = 64;
+
+    struct Block {
+        int start;      // Inicio absoluto del primer tramo del bloque
+        int offset;     // Posición de ese tramo en `bytes`
+    };
+
+    QByteArray bytes;
+    QVector<Block> blocks;
+    Segment open;           // Último tramo, sin codificar mientras todavía puede crecer
+    int encoded = 0;        // Tramos ya codificados
+    int encodedEnd = 0;     // Fin del último tramo codificado
+    int busy = 0;
+    QStringList names;
+    QHash<QString, int> ownerIndex;
+
+    void encode(const Segment &segment);
+    int blockFor(int time) const;   // Último bloque que empieza en o antes de `time`
+
+    // Recorre los tramos codificados del bloque `block` en adelante; fn devuelve false para parar
+    template <typename F>
+    void walk(int block, F fn) const;
+};
+
+inline void writeVarint(QByteArray &out, unsigned value)
+{
+    while (value >= 0x80) {
+        out.append(char(value | 0x80));
+        value >>= 7;
+    }
+    out.append(char(value));
+}
+
+inline unsigned readVarint(const char *&p)
+{
+    unsigned value = 0;
+    int shift = 0;
+    unsigned char byte;
+    do {
+        byte = static_cast<unsigned char>(*p++);
+        value |= unsigned(byte & 0x7f) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    return value;
+}
+
+template <typename F>
+void Timeline::walk(int block, F fn) const
+{
+    if (block < 0 || block >= blocks.size()) return;
+    const char *p = bytes.constData() + blocks[block].offset;
+    int index = block * BLOCK_SIZE;
+    int previousEnd = blocks[block].start;
+    for (; index < encoded; ++index) {
+        Segment segment;
+        int gap = int(readVarint(p));
+        segment.length = int(readVarint(p));
+        segment.owner = int(readVarint(p));
+        // El primer tramo de cada bloque empieza en el inicio guardado del bloque
+        segment.start = index % BLOCK_SIZE == 0 ? blocks[index / BLOCK_SIZE].start : previousEnd + gap;
+        previousEnd = segment.end();
+        if (!fn(index, segment)) return;
+    }
+}
+
+template <typename F>
+void Timeline::forEach(int from, int to, F fn) const
+{
+    if (from >= to) return;
+    bool done = false;
+    walk(std::max(0, blockFor(from)), [&](int, const Segment &segment) {
+        if (segment.start >= to) {
+            done = true;
+            return false;
+        }
+        if (segment.end() > from) fn(segment);
+        return true;
+    });
+    if (!done && open.length > 0 && open.start < to && open.end() > from) fn(open);
+}
+
+#endif // TIMELINE_H
@@ -0,0 +1,86 @@
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include <vector>
+#include <queue>
+#include <cstdint>
+
+// Rueda de tiempo para eventos programados por ciclo.
+// Los eventos dentro del horizonte de la rueda caen directo en su ranura (O(1));
+// los más lejanos esperan en un heap y se migran a la rueda cuando entran al horizonte,
+// así cada evento cuesta O(1) amortizado sin recorrer la lista completa de acciones.
+// takeDue debe consultarse con ciclos crecientes, uno por ciclo simulado.
+template <typename T>
+class TimerWheel
+{
+public:
+    explicit TimerWheel(int slots = 256) : buckets(slots), now(0), count(0), sequence(0) {}
+
+    void clear()
+    {
+        for (auto &bucket : buckets) bucket.clear();
+        overflow = std::priority_queue<Entry, std::vector<Entry>, Later>();
+        now = 0;
+        count = 0;
+        sequence = 0;
+    }
+
+    void schedule(int cycle, const T &item)
+    {
+        if (cycle < now) cycle = now;
+        Entry entry{cycle, sequence++, item};
+        if (cycle - now < int(buckets.size())) {
+            buckets[cycle % buckets.size()].push_back(entry);
+        } else {
+            overflow.push(entry);
+        }
+        count++;
+    }
+
+    // Agrega a `out` los eventos que vencen en `cycle` y los retira de la rueda
+    void takeDue(int cycle, std::vector<T> &out)
+    {
+        if (cycle < now) return;
+        now = cycle;
+
+        // Migrar del heap los eventos que ya entran en el horizonte
+        while (!overflow.empty() && overflow.top().cycle - now < int(buckets.size())) {
+            const Entry &entry = overflow.top();
+            buckets[entry.cycle % buckets.size()].push_back(entry);
+            overflow.pop();
+        }
+
+        std::vector<Entry> &bucket = buckets[cycle % buckets.size()];
+        for (const Entry &entry : bucket) {
+            out.push_back(entry.item);
+        }
+        count -= int(bucket.size());
+        bucket.clear();
+    }
+
+    bool empty() const { return count == 0; }
+    int size() const { return count; }
+
+private:
+    struct Entry {
+        int cycle;
+        std::uint64_t order;
+        T item;
+    };
+
+    struct Later {
+        bool operator()(const Entry &a, const Entry &b) const
+        {
+            if (a.cycle == b.cycle) return a.order > b.order;
+            return a.cycle > b.cycle;
+        }
+    };
+
+    std::vector<std::vector<Entry>> buckets;
+    std::priority_queue<Entry, std::vector<Entry>, Later> overflow;
+    int now;
+    int count;
+    std::uint64_t sequence;
+};
+
+#endif // TIMERWHEEL_H
@@ -0,0 +1,323 @@
+// Compara todos los algoritmos de calendarización sobre muchos archivos de procesos.
+//
+// Uso: scheduler_batch <directorio|archivo|patrón>... [--quantum N] [--aging N]
+//                      [--threads N] [--csv]
+//
+// Un directorio aporta todos sus .txt (también los de subdirectorios) y un patrón como
+// "trazas/*.txt" se expande aunque venga entre comillas. Cada par (archivo, algoritmo) es
+// una corrida independiente; las corridas se reparten entre tantos hilos como núcleos
+// (o --threads) y cada hilo toma la siguiente libre, empezando por los archivos con más
+// procesos para que una traza grande no quede sola al final. La salida es una tabla con
+// las métricas de la ventana de calendarización (completion, turnaround y response
+// promedio) más los percentiles 95 y 99, y un resumen por algoritmo. Con --csv se escribe
+// CSV sin los tiempos de ejecución, así dos corridas se comparan con diff.
+
+#include "cpusyncengine.h"
+#include "parallel.h"
+#include "realtimescheduler.h"
+#include "schedulemetrics.h"
+
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QSet>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct BatchOptions {
+    QStringList inputs;
+    int quantum = 2;
+    int agingInterval = 5;
+    int threads = 0;
+    bool csv = false;
+};
+
+struct Algorithm {
+    QString name;
+    bool realTime;
+    SchedulingAlgorithm algorithm;
+    RealTimePolicy policy;
+};
+
+struct Workload {
+    QString path;
+    QVector<Proceso> procesos;
+    int invalidLines = 0;
+    bool readable = false;
+};
+
+// Lo que queda de una corrida; los valores por proceso se descartan al terminarla
+struct RunSummary {
+    int processes = 0;
+    int totalCycles = 0;
+    int busyCycles = 0;
+    double avgCompletion = 0;
+    double avgTurnaround = 0;
+    double avgResponse = 0;
+    int p95Completion = 0;
+    int p99Completion = 0;
+    int p95Response = 0;
+    int p99Response = 0;
+    int maxResponse = 0;
+    double milliseconds = 0;
+};
+
+bool parseOptions(int argc, char *argv[], BatchOptions &options)
+{
+    bool ok = true;
+    for (int i = 1; i < argc && ok; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--quantum" && hasValue) options.quantum = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--aging" && hasValue) options.agingInterval = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--threads" && hasValue) options.threads = std::max(0, std::atoi(argv[++i]));
+        else if (arg == "--csv") options.csv = true;
+        else if (!arg.empty() && arg[0] != '-') options.inputs << QString::fromStdString(arg);
+        else ok = false;
+    }
+    if (!ok || options.inputs.isEmpty()) {
+        std::fprintf(stderr, "Uso: %s <directorio|archivo|patrón>... [--quantum N] [--aging N] "
+                             "[--threads N] [--csv]\n", argv[0]);
+        return false;
+    }
+    return true;
+}
+
+// Directorios, patrones y archivos sueltos a una lista ordenada y sin repetidos
+QStringList expandInputs(const QStringList &inputs)
+{
+    QStringList files;
+    QSet<QString> seen;
+    auto add = [&](const QFileInfo &info) {
+        if (seen.contains(info.absoluteFilePath())) return;
+        seen.insert(info.absoluteFilePath());
+        files << info.filePath();
+    };
+
+    for (const QString &input : inputs) {
+        QFileInfo info(input);
+        if (info.isDir()) {
+            QStringList found;
+            QDirIterator it(input, {"*.txt"}, QDir::Files, QDirIterator::Subdirectories);
+            while (it.hasNext()) found << it.next();
+            found.sort();
+            for (const QString &path : found) add(QFileInfo(path));
+        } else if (input.contains('*') || input.contains('?') || input.contains('[')) {
+            const QFileInfoList matches = QDir(info.path()).entryInfoList({info.fileName()}, QDir::Files, QDir::Name);
+            if (matches.isEmpty()) std::fprintf(stderr, "%s: no coincide con ningún archivo\n", qPrintable(input));
+            for (const QFileInfo &match : matches) add(match);
+        } else {
+            add(info);
+        }
+    }
+    return files;
+}
+
+QVector<Algorithm> algorithms(const BatchOptions &options)
+{
+    return {
+        {"FIFO", false, SchedulingAlgorithm::FIFO, RealTimePolicy::EDF},
+        {"SJF", false, SchedulingAlgorithm::SJF, RealTimePolicy::EDF},
+        {"SRT", false, SchedulingAlgorithm::SRT, RealTimePolicy::EDF},
+        {QString("RR(Q=%1)").arg(options.quantum), false, SchedulingAlgorithm::RoundRobin, RealTimePolicy::EDF},
+        {QString("Priority(T=%1)").arg(options.agingInterval), false, SchedulingAlgorithm::PriorityAging, RealTimePolicy::EDF},
+        {"EDF", true, SchedulingAlgorithm::FIFO, RealTimePolicy::EDF},
+        {"RM", true, SchedulingAlgorithm::FIFO, RealTimePolicy::RateMonotonic},
+    };
+}
+
+Workload loadWorkload(const QString &path)
+{
+    Workload workload;
+    workload.path = path;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) return workload;
+    QStringList errors;
+    workload.procesos = parseProcesses(QString::fromUtf8(file.readAll()), &errors);
+    workload.invalidLines = errors.size();
+    workload.readable = true;
+    return workload;
+}
+
+// Los cinco algoritmos de la ventana sin recursos (con E/S si las ráfagas la tienen) y los
+// dos de tiempo real, igual que los corre la ventana de calendarización
+RunSummary runOne(const QVector<Proceso> &procesos, const Algorithm &algorithm, const BatchOptions &options)
+{
+    auto start = std::chrono::steady_clock::now();
+    // EDF y RM reportan por trabajo: un PID periódico aparece muchas veces en el Gantt
+    ScheduleMetrics metrics;
+    if (algorithm.realTime) {
+        RealTimeConfig config;
+        config.policy = algorithm.policy;
+        metrics = simulateRealTime(procesos, config).jobMetrics;
+    } else {
+        CpuSyncConfig config;
+        config.algorithm = algorithm.algorithm;
+        config.quantum = options.quantum;
+        config.agingInterval = options.agingInterval;
+        metrics = computeScheduleMetrics(simulateCpuWithBlocking(procesos, QVector<Action>(), config).timeline, procesos);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    RunSummary summary;
+    summary.processes = metrics.processes;
+    summary.totalCycles = metrics.totalCycles;
+    summary.busyCycles = metrics.busyCycles;
+    summary.avgCompletion = metrics.avgCompletion;
+    summary.avgTurnaround = metrics.avgTurnaround;
+    summary.avgResponse = metrics.avgResponse;
+    summary.p95Completion = sortedPercentile(metrics.completion, 95);
+    summary.p99Completion = sortedPercentile(metrics.completion, 99);
+    summary.p95Response = sortedPercentile(metrics.response, 95);
+    summary.p99Response = sortedPercentile(metrics.response, 99);
+    summary.maxResponse = metrics.response.isEmpty() ? 0 : metrics.response.last();
+    summary.milliseconds = std::chrono::duration<double, std::milli>(elapsed).count();
+    return summary;
+}
+
+double cpuPercent(const RunSummary &run)
+{
+    return run.totalCycles > 0 ? 100.0 * run.busyCycles / run.totalCycles : 0.0;
+}
+
+void printTable(const std::vector<Workload> &workloads, const QVector<Algorithm> &algos,
+                const std::vector<RunSummary> &runs, bool csv)
+{
+    int pathWidth = 7;
+    int nameWidth = 9;
+    for (const Workload &w : workloads) pathWidth = std::max(pathWidth, int(w.path.size()));
+    for (const Algorithm &a : algos) nameWidth = std::max(nameWidth, int(a.name.size()));
+
+    if (csv) {
+        std::printf("archivo,algoritmo,procesos,ciclos,cpu,completion_prom,completion_p95,completion_p99,"
+                    "turnaround_prom,response_prom,response_p95,response_p99,response_max\n");
+    } else {
+        std::printf("%-*s %-*s %8s %9s %6s %10s %8s %8s %10s %10s %8s %8s %8s %9s\n",
+                    pathWidth, "archivo", nameWidth, "algoritmo", "procesos", "ciclos", "cpu%",
+                    "compl_avg", "c_p95", "c_p99", "turn_avg", "resp_avg", "r_p95", "r_p99", "r_max", "ms");
+    }
+
+    for (std::size_t f = 0; f < workloads.size(); ++f) {
+        const Workload &w = workloads[f];
+        if (!w.readable || w.procesos.isEmpty()) continue;
+        for (int a = 0; a < algos.size(); ++a) {
+            const RunSummary &run = runs[f * algos.size() + a];
+            if (csv) {
+                std::printf("%s,%s,%d,%d,%.1f,%.2f,%d,%d,%.2f,%.2f,%d,%d,%d\n",
+                            qPrintable(w.path), qPrintable(algos[a].name), run.processes, run.totalCycles,
+                            cpuPercent(run), run.avgCompletion, run.p95Completion, run.p99Completion,
+                            run.avgTurnaround, run.avgResponse, run.p95Response, run.p99Response, run.maxResponse);
+            } else {
+                std::printf("%-*s %-*s %8d %9d %6.1f %10.2f %8d %8d %10.2f %10.2f %8d %8d %8d %9.3f\n",
+                            pathWidth, qPrintable(w.path), nameWidth, qPrintable(algos[a].name),
+                            run.processes, run.totalCycles, cpuPercent(run), run.avgCompletion,
+                            run.p95Completion, run.p99Completion, run.avgTurnaround, run.avgResponse,
+                            run.p95Response, run.p99Response, run.maxResponse, run.milliseconds);
+            }
+        }
+    }
+}
+
+// Promedios ponderados por procesos, el peor p99 de respuesta y en cuántos archivos cada
+// algoritmo tuvo la menor respuesta promedio (un empate cuenta para todos los empatados)
+void printSummary(const std::vector<Workload> &workloads, const QVector<Algorithm> &algos,
+                  const std::vector<RunSummary> &runs, bool csv)
+{
+    const int count = algos.size();
+    std::vector<long long> processes(count, 0);
+    std::vector<double> completion(count, 0), turnaround(count, 0), response(count, 0);
+    std::vector<int> worstP99(count, 0), best(count, 0);
+    int files = 0;
+
+    for (std::size_t f = 0; f < workloads.size(); ++f) {
+        if (!workloads[f].readable || workloads[f].procesos.isEmpty()) continue;
+        files++;
+        double lowest = runs[f * count].avgResponse;
+        for (int a = 0; a < count; ++a) lowest = std::min(lowest, runs[f * count + a].avgResponse);
+        for (int a = 0; a < count; ++a) {
+            const RunSummary &run = runs[f * count + a];
+            processes[a] += run.processes;
+            completion[a] += run.avgCompletion * run.processes;
+            turnaround[a] += run.avgTurnaround * run.processes;
+            response[a] += run.avgResponse * run.processes;
+            worstP99[a] = std::max(worstP99[a], run.p99Response);
+            if (run.avgResponse == lowest) best[a]++;
+        }
+    }
+
+    if (csv) {
+        std::printf("\nalgoritmo,archivos,procesos,completion_prom,turnaround_prom,response_prom,"
+                    "peor_response_p99,mejor_response\n");
+    } else {
+        std::printf("\n%-16s %8s %10s %10s %10s %10s %10s %8s\n", "algoritmo", "archivos", "procesos",
+                    "compl_avg", "turn_avg", "resp_avg", "peor_r_p99", "mejor");
+    }
+    for (int a = 0; a < count; ++a) {
+        double n = std::max<long long>(1, processes[a]);
+        const char *format = csv ? "%s,%d,%lld,%.2f,%.2f,%.2f,%d,%d\n"
+                                 : "%-16s %8d %10lld %10.2f %10.2f %10.2f %10d %8d\n";
+        std::printf(format, qPrintable(algos[a].name), files, processes[a], completion[a] / n,
+                    turnaround[a] / n, response[a] / n, worstP99[a], best[a]);
+    }
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    BatchOptions options;
+    if (!parseOptions(argc, argv, options)) return 1;
+
+    const QStringList paths = expandInputs(options.inputs);
+    if (paths.isEmpty()) {
+        std::fprintf(stderr, "No hay archivos de procesos que comparar\n");
+        return 1;
+    }
+    const QVector<Algorithm> algos = algorithms(options);
+    auto start = std::chrono::steady_clock::now();
+
+    // Lectura y parseo, un archivo por índice
+    std::vector<Workload> workloads(paths.size());
+    parallelFor(paths.size(), [&](int f) { workloads[f] = loadWorkload(paths[f]); }, options.threads);
+
+    for (const Workload &w : workloads) {
+        if (!w.readable) std::fprintf(stderr, "No se pudo abrir %s\n", qPrintable(w.path));
+        else if (w.invalidLines > 0) std::fprintf(stderr, "%s: %d líneas inválidas omitidas\n", qPrintable(w.path), w.invalidLines);
+    }
+
+    // Una corrida por (archivo, algoritmo); las de los archivos más grandes salen primero
+    std::vector<int> order;
+    for (std::size_t f = 0; f < workloads.size(); ++f) {
+        if (!workloads[f].readable || workloads[f].procesos.isEmpty()) continue;
+        for (int a = 0; a < algos.size(); ++a) order.push_back(int(f) * algos.size() + a);
+    }
+    std::stable_sort(order.begin(), order.end(), [&](int x, int y) {
+        return workloads[x / algos.size()].procesos.size() > workloads[y / algos.size()].procesos.size();
+    });
+
+    std::vector<RunSummary> runs(workloads.size() * algos.size());
+    parallelFor(int(order.size()), [&](int i) {
+        int run = order[i];
+        runs[run] = runOne(workloads[run / algos.size()].procesos, algos[run % algos.size()], options);
+    }, options.threads);
+
+    double wall = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    double busy = 0;
+    for (const RunSummary &run : runs) busy += run.milliseconds;
+
+    printTable(workloads, algos, runs, options.csv);
+    printSummary(workloads, algos, runs, options.csv);
+
+    int threads = options.threads > 0 ? options.threads : int(std::max(1u, std::thread::hardware_concurrency()));
+    std::fprintf(stderr, "# %d archivos, %zu corridas, hilos: %d, %.1f ms (%.1f ms sumando las corridas)\n",
+                 int(paths.size()), order.size(), threads, wall, busy);
+    return 0;
+}
@@ -0,0 +1,141 @@
+// Calendarizador en línea que lee llegadas de procesos desde la entrada estándar o un FIFO.
+//
+// Uso: scheduler_stream [procesos.txt|-] [--policy fifo|sjf|srt|rr|priority] [--quantum N]
+//                       [--aging N] [--window N] [--report N] [--quiet]
+//
+// Cada línea tiene el formato del archivo de procesos (PID, BT, AT, Priority) y debe llegar
+// en orden de AT; una llegada atrasada se admite en el ciclo actual. Los tramos de CPU se
+// escriben como "PID,inicio,duracion" en cuanto se cierran y cada --report ciclos se escribe
+// una línea "# ..." con las métricas acumuladas y las de los últimos --window procesos.
+// La memoria no crece con la longitud de la traza, así que sirve para cargas capturadas en
+// vivo o generadas sin fin (por ejemplo: generador | scheduler_stream --policy rr).
+
+#include "onlinescheduler.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace {
+
+struct StreamOptions {
+    std::string inputPath = "-";
+    OnlineConfig config;
+    int reportEvery = 1000;
+    bool quiet = false;
+};
+
+bool parsePolicy(const std::string &name, SchedulingAlgorithm &algorithm)
+{
+    if (name == "fifo") algorithm = SchedulingAlgorithm::FIFO;
+    else if (name == "sjf") algorithm = SchedulingAlgorithm::SJF;
+    else if (name == "srt") algorithm = SchedulingAlgorithm::SRT;
+    else if (name == "rr") algorithm = SchedulingAlgorithm::RoundRobin;
+    else if (name == "priority") algorithm = SchedulingAlgorithm::PriorityAging;
+    else return false;
+    return true;
+}
+
+bool parseOptions(int argc, char *argv[], StreamOptions &options)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        bool ok = true;
+        if (arg == "--policy" && hasValue) ok = parsePolicy(argv[++i], options.config.algorithm);
+        else if (arg == "--quantum" && hasValue) options.config.quantum = std::atoi(argv[++i]);
+        else if (arg == "--aging" && hasValue) options.config.agingInterval = std::atoi(argv[++i]);
+        else if (arg == "--window" && hasValue) options.config.metricsWindow = std::atoi(argv[++i]);
+        else if (arg == "--report" && hasValue) options.reportEvery = std::max(1, std::atoi(argv[++i]));
+        else if (arg == "--quiet") options.quiet = true;
+        else if (arg == "-" || (!arg.empty() && arg[0] != '-')) options.inputPath = arg;
+        else ok = false;
+
+        if (!ok) {
+            std::fprintf(stderr, "Uso: %s [procesos.txt|-] [--policy fifo|sjf|srt|rr|priority] [--quantum N] "
+                                 "[--aging N] [--window N] [--report N] [--quiet]\n", argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+void report(const OnlineMetrics &m)
+{
+    long long elapsed = m.busyCycles + m.idleCycles;
+    std::printf("# ciclo=%d llegadas=%lld terminados=%lld en_sistema=%d max_en_sistema=%d cpu=%.1f%% "
+                "espera=%.2f respuesta=%.2f retorno=%.2f ventana=%d atrasados=%lld\n",
+                m.cycle, m.submitted, m.completed, m.inSystem, m.peakInSystem,
+                elapsed > 0 ? 100.0 * m.busyCycles / elapsed : 0.0,
+                m.windowWaiting, m.windowResponse, m.windowTurnaround, m.windowSize, m.lateArrivals);
+    std::fflush(stdout);
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    StreamOptions options;
+    if (!parseOptions(argc, argv, options)) return 1;
+
+    std::ifstream file;
+    std::istream *input = &std::cin;
+    if (options.inputPath != "-") {
+        // Un FIFO con nombre se abre igual que un archivo; la lectura espera al escritor
+        file.open(options.inputPath);
+        if (!file) {
+            std::fprintf(stderr, "No se pudo abrir %s\n", options.inputPath.c_str());
+            return 1;
+        }
+        input = &file;
+    }
+
+    bool quiet = options.quiet;
+    OnlineScheduler scheduler(options.config, [quiet](const ResultadoSimulacion &segment) {
+        if (!quiet) std::printf("%s,%d,%d\n", segment.PID.toStdString().c_str(), segment.inicio, segment.duracion);
+    });
+
+    // Reporta en cada múltiplo de --report; los tramos ociosos sin procesos se saltan
+    long long nextReport = options.reportEvery;
+    auto reportUntil = [&](long long cycle) {
+        while (nextReport <= cycle) {
+            if (scheduler.idle()) {
+                nextReport += (cycle - nextReport) / options.reportEvery * options.reportEvery;
+            }
+            scheduler.advanceTo(int(nextReport));
+            report(scheduler.metrics());
+            nextReport += options.reportEvery;
+        }
+    };
+
+    std::string line;
+    long long lineNumber = 0;
+    while (std::getline(*input, line)) {
+        lineNumber++;
+        QString text = QString::fromStdString(line);
+        if (text.trimmed().isEmpty() || text.trimmed().startsWith('#')) continue;
+
+        Proceso proceso;
+        QString error;
+        if (!parseProcessLine(text, proceso, &error)) {
+            std::fprintf(stderr, "Línea %lld: %s\n", lineNumber, error.toStdString().c_str());
+            continue;
+        }
+        reportUntil(proceso.AT);
+        scheduler.submit(proceso);
+    }
+
+    // Fin de la entrada: se sigue reportando mientras quede trabajo
+    while (!scheduler.idle()) {
+        scheduler.drainTo(int(nextReport));
+        if (scheduler.metrics().cycle < nextReport) break;
+        report(scheduler.metrics());
+        nextReport += options.reportEvery;
+    }
+    scheduler.finish();
+    report(scheduler.metrics());
+    return 0;
+}